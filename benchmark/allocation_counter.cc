@@ -0,0 +1,45 @@
+#include "allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+// The count is per thread so that counting does not add contention to multi-threaded benchmarks.
+static thread_local size_t allocation_count = 0;
+
+size_t ThreadAllocationCount() {
+  return allocation_count;
+}
+
+void* operator new(size_t size) {
+  ++allocation_count;
+  if (void* ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t align) {
+  ++allocation_count;
+  size_t alignment = static_cast<size_t>(align);
+  // aligned_alloc requires the size to be a multiple of the alignment.
+  if (void* ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Returns how many heap allocations the calling thread has made so far.
+ *
+ * Linking allocation_counter.cc into a binary replaces the global operator new and delete
+ * with versions that count every allocation. Benchmarks take the difference of two readings
+ * to report allocations per operation.
+ *
+ * @return The number of calls to operator new made by the calling thread.
+ */
+size_t ThreadAllocationCount();
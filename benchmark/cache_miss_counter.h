@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Counts the hardware cache misses of the calling thread between start() and stop().
+ *
+ * Uses the Linux perf_event interface to count last-level cache misses in user space. Where that
+ * is not available (other systems, or a kernel that forbids it), available() is false and stop()
+ * always returns 0, so benchmarks can still run and just leave the counter out.
+ */
+class CacheMissCounter {
+public:
+  CacheMissCounter();
+  ~CacheMissCounter();
+
+  CacheMissCounter(const CacheMissCounter&) = delete;
+  CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+  /**
+   * @brief Checks whether the counter could be opened.
+   */
+  bool available() const {
+    return fd_ >= 0;
+  }
+
+  /**
+   * @brief Resets the count and starts counting.
+   */
+  void start();
+
+  /**
+   * @brief Stops counting.
+   *
+   * @return The cache misses since the last start().
+   */
+  uint64_t stop();
+
+private:
+  int fd_;  ///< The perf event file descriptor, or -1.
+};
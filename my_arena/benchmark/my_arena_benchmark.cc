@@ -0,0 +1,235 @@
+#include <malloc.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "my_arena.h"
+#include "my_arena_offset_ptr.h"
+#include "my_tagged_unique_ptr.h"
+#include "my_unique_ptr.h"
+
+namespace {
+
+constexpr int64_t kObjectsPerRequest = 1'000'000;
+
+// A small trivially destructible object: the arena records nothing for it.
+struct Point {
+  explicit Point(int64_t i) : x(i), y(-i) {}
+  int64_t x;
+  int64_t y;
+};
+
+// A small object with a destructor, which the arena has to run.
+struct Tagged {
+  explicit Tagged(int64_t i) : id(i) {}
+  ~Tagged() { benchmark::DoNotOptimize(id); }
+  int64_t id;
+  int64_t padding{0};
+};
+
+// Every "request" makes state.range(0) objects, keeps a pointer to each and lets all of them go at
+// the end, as handlers do with their per-request state.
+template<typename T>
+void BM_HeapRequest(benchmark::State& state) {
+  std::vector<MyUniquePtr<T>> objects;
+  objects.reserve(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      objects.push_back(MakeMyUnique<T>(i));
+    }
+    objects.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Scoped owners: each MyArenaPtr runs its destructor, reset() reclaims the memory.
+template<typename T>
+void BM_ArenaPtrRequest(benchmark::State& state) {
+  MyArena arena;
+  std::vector<MyArenaPtr<T>> objects;
+  objects.reserve(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      objects.push_back(MakeMyArenaPtr<T>(arena, i));
+    }
+    objects.clear();
+    arena.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Arena-owned objects: reset() runs the recorded destructors, if any, and reclaims the memory.
+template<typename T>
+void BM_ArenaCreateRequest(benchmark::State& state) {
+  MyArena arena;
+  std::vector<T*> objects;
+  objects.reserve(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      objects.push_back(arena.create<T>(i));
+    }
+    objects.clear();
+    arena.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_HeapRequest, Point)->Arg(kObjectsPerRequest)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ArenaPtrRequest, Point)->Arg(kObjectsPerRequest)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ArenaCreateRequest, Point)->Arg(kObjectsPerRequest)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_HeapRequest, Tagged)->Arg(kObjectsPerRequest)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ArenaPtrRequest, Tagged)->Arg(kObjectsPerRequest)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ArenaCreateRequest, Tagged)->Arg(kObjectsPerRequest)->Unit(benchmark::kMillisecond);
+
+// Binary tries over 32-bit keys, one node per key bit, in four layouts of the same node: two
+// children and a flag that marks the end of a key. Each *Trie struct names its node and how to
+// make the root and a child and read or set the flag.
+
+// Children on the heap, as with plain MyUniquePtr: 24-byte nodes, 32 bytes with malloc's header.
+struct HeapTrie {
+  struct Node {
+    MyUniquePtr<Node> children[2];
+    bool terminal = false;
+  };
+  static Node* child(Node* node, int bit) { return node->children[bit].get(); }
+  static Node* make_child(Node* node, int bit, MyArena&) {
+    node->children[bit] = MakeMyUnique<Node>();
+    return node->children[bit].get();
+  }
+  static bool terminal(const Node* node) { return node->terminal; }
+  static void set_terminal(Node* node) { node->terminal = true; }
+  static MyUniquePtr<Node> make_root(MyArena&) { return MakeMyUnique<Node>(); }
+  static constexpr bool kSingleChunk = false;
+};
+
+// The same 24-byte nodes from an arena.
+struct ArenaTrie {
+  struct Node {
+    MyArenaPtr<Node> children[2];
+    bool terminal = false;
+  };
+  static Node* child(Node* node, int bit) { return node->children[bit].get(); }
+  static Node* make_child(Node* node, int bit, MyArena& arena) {
+    node->children[bit] = MakeMyArenaPtr<Node>(arena);
+    return node->children[bit].get();
+  }
+  static bool terminal(const Node* node) { return node->terminal; }
+  static void set_terminal(Node* node) { node->terminal = true; }
+  static MyArenaPtr<Node> make_root(MyArena& arena) { return MakeMyArenaPtr<Node>(arena); }
+  static constexpr bool kSingleChunk = false;
+};
+
+// The flag moves into a tag bit of the first child: 16-byte nodes.
+struct TaggedTrie {
+  struct Node {
+    MyTaggedUniquePtr<Node, 1, MyArenaDeleter<Node>> children[2];
+  };
+  static Node* child(Node* node, int bit) { return node->children[bit].get(); }
+  static Node* make_child(Node* node, int bit, MyArena& arena) {
+    node->children[bit].reset(MakeMyArenaPtr<Node>(arena).release());
+    return node->children[bit].get();
+  }
+  static bool terminal(const Node* node) { return node->children[0].tag() != 0; }
+  static void set_terminal(Node* node) { node->children[0].set_tag(1); }
+  static MyArenaPtr<Node> make_root(MyArena& arena) { return MakeMyArenaPtr<Node>(arena); }
+  static constexpr bool kSingleChunk = false;
+};
+
+// 32-bit offsets instead of pointers: 12-byte nodes, in one contiguous chunk.
+struct OffsetTrie {
+  struct Node {
+    MyArenaOffsetPtr<Node> children[2];
+    bool terminal = false;
+  };
+  static Node* child(Node* node, int bit) { return node->children[bit].get(); }
+  static Node* make_child(Node* node, int bit, MyArena& arena) {
+    return &node->children[bit].emplace(arena);
+  }
+  static bool terminal(const Node* node) { return node->terminal; }
+  static void set_terminal(Node* node) { node->terminal = true; }
+  static MyArenaPtr<Node> make_root(MyArena& arena) { return MakeMyArenaPtr<Node>(arena); }
+  static constexpr bool kSingleChunk = true;
+};
+
+template<typename Trie>
+MyArena MakeTrieArena(int64_t nodes) {
+  if constexpr (Trie::kSingleChunk) {
+    return MyArena(MyArena::SingleChunk(), static_cast<size_t>(nodes + 64) * sizeof(typename Trie::Node));
+  } else {
+    return MyArena(MyArena::kMaxChunkSize);
+  }
+}
+
+template<typename Trie>
+void Insert(typename Trie::Node* root, uint32_t key, MyArena& arena, int64_t& nodes) {
+  typename Trie::Node* node = root;
+  for (int shift = 31; shift >= 0; --shift) {
+    int bit = (key >> shift) & 1;
+    typename Trie::Node* next = Trie::child(node, bit);
+    if (next == nullptr) {
+      next = Trie::make_child(node, bit, arena);
+      ++nodes;
+    }
+    node = next;
+  }
+  Trie::set_terminal(node);
+}
+
+template<typename Trie>
+bool Contains(typename Trie::Node* root, uint32_t key) {
+  typename Trie::Node* node = root;
+  for (int shift = 31; shift >= 0 && node; --shift) {
+    node = Trie::child(node, (key >> shift) & 1);
+  }
+  return node && Trie::terminal(node);
+}
+
+size_t HeapBytesInUse() {
+  return mallinfo2().uordblks + mallinfo2().hblkhd;
+}
+
+// Inserts random keys until the trie has state.range(0) nodes, then times lookups of keys that
+// are all present, each a walk from the root to a leaf 32 levels down.
+template<typename Trie>
+void BM_TrieLookup(benchmark::State& state) {
+  using Node = typename Trie::Node;
+  constexpr int64_t kLookups = 1'000'000;
+  size_t heap_before = HeapBytesInUse();
+  MyArena arena = MakeTrieArena<Trie>(state.range(0));
+  auto root = Trie::make_root(arena);
+  int64_t nodes = 1;
+  std::vector<uint32_t> keys;
+  std::mt19937 rng(42);
+  while (nodes < state.range(0)) {
+    uint32_t key = rng();
+    Insert<Trie>(root.get(), key, arena, nodes);
+    if (keys.size() < static_cast<size_t>(kLookups)) {
+      keys.push_back(key);
+    }
+  }
+  size_t trie_bytes = HeapBytesInUse() - heap_before - keys.capacity() * sizeof(uint32_t);
+  std::shuffle(keys.begin(), keys.end(), rng);
+
+  for (auto _ : state) {
+    int64_t found = 0;
+    for (uint32_t key : keys) {
+      found += Contains<Trie>(root.get(), key);
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+  state.counters["node_bytes"] = static_cast<double>(sizeof(Node));
+  state.counters["trie_MB"] = static_cast<double>(trie_bytes) / (1 << 20);
+}
+
+constexpr int64_t kTrieNodes = 50'000'000;
+
+BENCHMARK_TEMPLATE(BM_TrieLookup, HeapTrie)->Arg(kTrieNodes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TrieLookup, ArenaTrie)->Arg(kTrieNodes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TrieLookup, TaggedTrie)->Arg(kTrieNodes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TrieLookup, OffsetTrie)->Arg(kTrieNodes)->Unit(benchmark::kMillisecond);
+
+}  // namespace
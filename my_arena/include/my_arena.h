@@ -0,0 +1,247 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "my_unique_ptr.h"
+
+/**
+ * @brief A monotonic bump allocator for objects that die together, such as everything made while
+ * serving one request.
+ *
+ * Memory is handed out from chunks by bumping a pointer, so an allocation is an add and a compare.
+ * Nothing is freed individually: reset() releases everything at once. If a round needed several
+ * chunks, the next one starts with a single chunk as big as all of them, so an arena reused for
+ * similar requests stops calling the general-purpose allocator after the second round. Within a
+ * round, each new chunk is twice the size of the previous one, up to kMaxChunkSize, and an
+ * allocation bigger than that gets a chunk of its own.
+ *
+ * Objects made with create() belong to the arena. If their type is not trivially destructible,
+ * create() records a destructor, which reset() and ~MyArena() run in reverse order of creation;
+ * trivially destructible objects are not recorded at all. MyArenaPtr is the alternative for
+ * objects whose destructor should run as soon as they go out of scope.
+ *
+ * A MyArena is not thread-safe; give each thread or request its own.
+ */
+class MyArena {
+public:
+  /**
+   * @brief The largest chunk the arena grows to on its own.
+   */
+  static constexpr size_t kMaxChunkSize = size_t{1} << 20;
+
+  /**
+   * @brief Selects the constructor that makes an arena of exactly one chunk.
+   */
+  struct SingleChunk {};
+
+  /**
+   * @brief Constructs an empty arena; no memory is allocated until the first allocation.
+   *
+   * @param initial_chunk_size The size of the first chunk, in bytes.
+   */
+  explicit MyArena(size_t initial_chunk_size = 4096) noexcept;
+
+  /**
+   * @brief Constructs an arena that allocates one chunk of capacity bytes up front and never
+   * grows, so that all its objects lie in one contiguous block, as MyArenaOffsetPtr needs.
+   *
+   * A large chunk is mapped by the system allocator and its pages are only committed when first
+   * written, so generous capacities cost address space rather than memory.
+   *
+   * @param capacity The size of the chunk, in bytes.
+   * @throws std::bad_alloc from allocations that do not fit in the remaining space.
+   */
+  MyArena(SingleChunk, size_t capacity);
+
+  MyArena(const MyArena&) = delete;
+  MyArena& operator=(const MyArena&) = delete;
+
+  /**
+   * @brief Runs the recorded destructors and frees all chunks.
+   */
+  ~MyArena();
+
+  /**
+   * @brief Allocates size bytes aligned to align.
+   *
+   * @param size The number of bytes.
+   * @param align The alignment, a power of two.
+   * @return The memory, valid until reset() or the arena's destruction.
+   */
+  void* allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+    size_t padding = (0 - reinterpret_cast<uintptr_t>(current_)) & (align - 1);
+    size_t remaining = static_cast<size_t>(end_ - current_);
+    // Written so that a huge size cannot wrap the sum around and pass.
+    if (padding <= remaining && size <= remaining - padding) {
+      void* memory = current_ + padding;
+      current_ += padding + size;
+      return memory;
+    }
+    return allocate_slow(size, align);
+  }
+
+  /**
+   * @brief Constructs an object owned by the arena.
+   *
+   * The object lives until reset() or the arena's destruction, which run its destructor unless
+   * T is trivially destructible.
+   *
+   * @param args Arguments forwarded to the constructor of T.
+   * @return A pointer to the object; never null.
+   */
+  template<typename T, typename... Args>
+  T* create(Args&&... args) {
+    if constexpr (std::is_trivially_destructible_v<T>) {
+      return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    } else {
+      // Allocate the record first, so that an object is never left without one.
+      Destructor* destructor = static_cast<Destructor*>(allocate(sizeof(Destructor), alignof(Destructor)));
+      T* object = ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+      destructor->destroy = [](void* object) { static_cast<T*>(object)->~T(); };
+      destructor->object = object;
+      destructor->next = destructors_;
+      destructors_ = destructor;
+      return object;
+    }
+  }
+
+  /**
+   * @brief Runs the recorded destructors and makes all memory available again.
+   *
+   * A single chunk is kept for reuse; several are freed and replaced by one big enough for all of
+   * them at the next allocation. Pointers into the arena, including MyArenaPtr instances, must not
+   * be used afterwards.
+   */
+  void reset() noexcept;
+
+  /**
+   * @brief Retrieves the number of bytes handed out since construction or the last reset(),
+   * including alignment padding and destructor records.
+   */
+  size_t bytes_used() const noexcept {
+    return used_before_current_ + static_cast<size_t>(current_ - chunk_begin());
+  }
+
+  /**
+   * @brief Retrieves the number of bytes of chunk memory the arena holds.
+   */
+  size_t bytes_reserved() const noexcept {
+    return reserved_;
+  }
+
+private:
+  struct Chunk {
+    Chunk* previous;  ///< The chunk allocated before this one.
+    size_t size;      ///< Usable bytes after the header.
+  };
+
+  struct Destructor {
+    void (*destroy)(void*);
+    void* object;
+    Destructor* next;  ///< The record of the object created before this one.
+  };
+
+  void* allocate_slow(size_t size, size_t align);
+
+  void add_chunk(size_t chunk_size);
+
+  void run_destructors() noexcept;
+
+  char* chunk_begin() const noexcept {
+    return chunks_ ? reinterpret_cast<char*>(chunks_ + 1) : nullptr;
+  }
+
+  char* current_ = nullptr;            ///< The next free byte of the newest chunk.
+  char* end_ = nullptr;                ///< The end of the newest chunk.
+  Chunk* chunks_ = nullptr;            ///< The newest chunk; the others are linked through previous.
+  Destructor* destructors_ = nullptr;  ///< The most recently recorded destructor.
+  size_t next_chunk_size_;             ///< The size of the next chunk to allocate.
+  size_t used_before_current_ = 0;     ///< Bytes used in chunks older than the newest one.
+  size_t reserved_ = 0;                ///< Total bytes of all chunks.
+  bool growable_ = true;               ///< False for a SingleChunk arena.
+};
+
+/**
+ * @brief The deleter of MyArenaPtr: runs the destructor and leaves the memory to the arena.
+ *
+ * Stateless, so MyArenaPtr<T> is as big as a T*; for a trivially destructible T it does nothing
+ * at all.
+ *
+ * @tparam T The type of the object to destroy.
+ */
+template<typename T>
+struct MyArenaDeleter {
+  void operator()(T* object) const noexcept {
+    object->~T();
+  }
+};
+
+/**
+ * @brief An owning pointer to an object in a MyArena: the destructor runs when the pointer goes
+ * away, the memory is reclaimed by MyArena::reset().
+ *
+ * It must be destroyed or released before its arena is reset.
+ */
+template<typename T>
+using MyArenaPtr = MyUniquePtr<T, MyArenaDeleter<T>>;
+
+/**
+ * @brief Constructs an object in arena, owned by the returned MyArenaPtr.
+ *
+ * Unlike MyArena::create(), no destructor is recorded with the arena: the pointer runs it.
+ *
+ * @tparam T The type of the object to create.
+ * @param arena The arena that provides the memory.
+ * @param args Arguments forwarded to the constructor of T.
+ * @return A MyArenaPtr owning the new object.
+ */
+template<typename T, typename... Args>
+MyArenaPtr<T> MakeMyArenaPtr(MyArena& arena, Args&&... args) {
+  return MyArenaPtr<T>(::new (arena.allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief A standard allocator that allocates from a MyArena and never frees, for containers and
+ * AllocateMyShared within a request.
+ *
+ * @tparam T The type of the objects to allocate.
+ */
+template<typename T>
+class MyArenaAllocator {
+public:
+  using value_type = T;
+
+  explicit MyArenaAllocator(MyArena& arena) noexcept : arena_(&arena) {}
+
+  template<typename U>
+  MyArenaAllocator(const MyArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (n > SIZE_MAX / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, size_t) noexcept {}
+
+  MyArena* arena() const noexcept {
+    return arena_;
+  }
+
+  template<typename U>
+  bool operator==(const MyArenaAllocator<U>& other) const noexcept {
+    return arena_ == other.arena();
+  }
+
+  template<typename U>
+  bool operator!=(const MyArenaAllocator<U>& other) const noexcept {
+    return arena_ != other.arena();
+  }
+
+private:
+  MyArena* arena_;
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "my_arena.h"
+
+/**
+ * @brief A 32-bit owning pointer between objects in a MyArena, for node-heavy structures.
+ *
+ * It stores the signed distance from itself to the object it owns, so it is half the size of a
+ * pointer and needs no base address to be dereferenced or to destroy its object. Nodes of a tree
+ * or trie allocated from one arena point at each other with it; the root, which usually lives
+ * elsewhere, is held by a MyArenaPtr. Create objects for it with emplace().
+ *
+ * Ownership works as in MyArenaPtr: the pointer runs its object's destructor when it goes away
+ * and leaves the memory to the arena. Making, moving or resetting one so that its object is more
+ * than 2 GB away throws std::length_error. Use an arena made with MyArena::SingleChunk of at
+ * most 2 GB, whose objects are all within range of each other; the chunks of a growing arena
+ * are separate allocations that may lie anywhere. A pointer outside the arena, e.g. on the
+ * stack, is usually out of range too, so take the object out with release() to move it
+ * elsewhere. For the same reason the pointer is not trivially relocatable.
+ *
+ * @tparam T The type of the object managed by this pointer.
+ */
+template<typename T>
+class MyArenaOffsetPtr {
+public:
+  /**
+   * @brief Constructs an empty pointer.
+   */
+  MyArenaOffsetPtr() noexcept = default;
+
+  /**
+   * @brief Constructs a pointer owning ptr.
+   *
+   * @param ptr An object in a MyArena, or nullptr.
+   * @throws std::length_error if ptr is too far away from this pointer.
+   */
+  explicit MyArenaOffsetPtr(T* ptr) : offset_(encode(ptr)) {}
+
+  MyArenaOffsetPtr(const MyArenaOffsetPtr&) = delete;
+  MyArenaOffsetPtr& operator=(const MyArenaOffsetPtr&) = delete;
+
+  /**
+   * @brief Move constructor. The distance is recomputed for the new address.
+   *
+   * @throws std::length_error if the object is too far away from this pointer; other then keeps
+   * the object.
+   */
+  MyArenaOffsetPtr(MyArenaOffsetPtr&& other) : offset_(encode(other.get())) {
+    other.offset_ = 0;
+  }
+
+  /**
+   * @brief Move assignment operator. Destroys the current object, then takes other's.
+   *
+   * @throws std::length_error if the object is too far away from this pointer; nothing changes
+   * then.
+   */
+  MyArenaOffsetPtr& operator=(MyArenaOffsetPtr&& other) {
+    if (this != &other) {
+      reset(other.get());
+      other.offset_ = 0;
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Runs the destructor of the managed object, if any.
+   */
+  ~MyArenaOffsetPtr() {
+    if (T* ptr = get()) {
+      ptr->~T();
+    }
+  }
+
+  T& operator*() const noexcept {
+    return *get();
+  }
+
+  T* operator->() const noexcept {
+    return get();
+  }
+
+  T* get() const noexcept {
+    if (offset_ == 0) {
+      return nullptr;
+    }
+    return reinterpret_cast<T*>(reinterpret_cast<intptr_t>(this) + offset_);
+  }
+
+  explicit operator bool() const noexcept {
+    return offset_ != 0;
+  }
+
+  /**
+   * @brief Releases ownership of the managed object without destroying it.
+   */
+  T* release() noexcept {
+    T* ptr = get();
+    offset_ = 0;
+    return ptr;
+  }
+
+  /**
+   * @brief Replaces the managed object, destroying the old one.
+   *
+   * @throws std::length_error if ptr is too far away from this pointer; nothing changes then.
+   */
+  void reset(T* ptr = nullptr) {
+    T* old = get();
+    if (old != ptr) {
+      offset_ = encode(ptr);
+      if (old) {
+        old->~T();
+      }
+    }
+  }
+
+  /**
+   * @brief Constructs an object in arena and makes this pointer its owner, destroying the old one.
+   *
+   * The way to create objects for a MyArenaOffsetPtr: a pointer returned by value would pass
+   * through the stack, too far from the arena.
+   *
+   * @param arena The arena that provides the memory.
+   * @param args Arguments forwarded to the constructor of T.
+   * @return A reference to the new object.
+   * @throws std::length_error if the new object is too far away from this pointer.
+   */
+  template<typename... Args>
+  T& emplace(MyArena& arena, Args&&... args) {
+    T* ptr = ::new (arena.allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    try {
+      reset(ptr);
+    } catch (...) {
+      ptr->~T();
+      throw;
+    }
+    return *ptr;
+  }
+
+private:
+  int32_t encode(T* ptr) const {
+    if (ptr == nullptr) {
+      return 0;
+    }
+    intptr_t offset = reinterpret_cast<intptr_t>(ptr) - reinterpret_cast<intptr_t>(this);
+    if (offset < INT32_MIN || offset > INT32_MAX) {
+      throw std::length_error("MyArenaOffsetPtr: object is too far away");
+    }
+    return static_cast<int32_t>(offset);
+  }
+
+  int32_t offset_ = 0;  ///< Distance in bytes from this pointer to the object; 0 when empty.
+};
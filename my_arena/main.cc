@@ -0,0 +1,36 @@
+#include <iostream>
+#include "my_arena.h"
+
+/**
+ * @brief A test class for MyArena.
+ *
+ * It prints messages upon construction and destruction to help observe when objects in an arena
+ * are destroyed: at the end of their MyArenaPtr's scope, or when the arena is reset.
+ */
+class Object {
+ public:
+  explicit Object(const char* name) : name_(name) {
+    std::cout << "Object " << name_ << " constructor" << std::endl;
+  }
+
+  ~Object() {
+    std::cout << "Object " << name_ << " destructor" << std::endl;
+  }
+
+ private:
+  const char* name_;
+};
+
+int main() {
+  MyArena arena;
+  Object* owned_by_arena = arena.create<Object>("a");
+  {
+    MyArenaPtr<Object> scoped = MakeMyArenaPtr<Object>(arena, "b");
+    std::cout << "scoped " << (scoped ? "has" : "does not have") << " an object" << std::endl;
+  }
+  std::cout << "owned_by_arena is at " << owned_by_arena << ", bytes used: " << arena.bytes_used() << std::endl;
+  std::cout << "--------------------------------" << std::endl;
+
+  arena.reset();
+  std::cout << "bytes used after reset: " << arena.bytes_used() << std::endl;
+}
@@ -0,0 +1,72 @@
+#include "my_arena.h"
+
+#include <algorithm>
+
+MyArena::MyArena(size_t initial_chunk_size) noexcept
+    : next_chunk_size_(std::max<size_t>(initial_chunk_size, 64)) {}
+
+MyArena::MyArena(SingleChunk, size_t capacity) : next_chunk_size_(capacity), growable_(false) {
+  add_chunk(capacity);
+}
+
+MyArena::~MyArena() {
+  run_destructors();
+  while (chunks_) {
+    Chunk* previous = chunks_->previous;
+    ::operator delete(chunks_);
+    chunks_ = previous;
+  }
+}
+
+void* MyArena::allocate_slow(size_t size, size_t align) {
+  if (!growable_) {
+    throw std::bad_alloc();
+  }
+  // Enough for size bytes at any alignment up to align past the chunk header.
+  size_t needed = size + align;
+  if (needed < size) {
+    throw std::bad_alloc();
+  }
+  add_chunk(std::max(next_chunk_size_, needed));
+  next_chunk_size_ = std::min(next_chunk_size_ * 2, kMaxChunkSize);
+  return allocate(size, align);
+}
+
+void MyArena::add_chunk(size_t chunk_size) {
+  Chunk* chunk = static_cast<Chunk*>(::operator new(sizeof(Chunk) + chunk_size));
+  chunk->previous = chunks_;
+  chunk->size = chunk_size;
+  if (chunks_) {
+    used_before_current_ += static_cast<size_t>(current_ - chunk_begin());
+  }
+  chunks_ = chunk;
+  current_ = chunk_begin();
+  end_ = current_ + chunk_size;
+  reserved_ += chunk_size;
+}
+
+void MyArena::run_destructors() noexcept {
+  while (destructors_) {
+    Destructor* destructor = destructors_;
+    destructors_ = destructor->next;
+    destructor->destroy(destructor->object);
+  }
+}
+
+void MyArena::reset() noexcept {
+  run_destructors();
+  if (chunks_ && chunks_->previous) {
+    // The last round needed several chunks. Free them all and let the next round start with one
+    // chunk as big as all of them together, so that a steady workload settles on a single chunk.
+    next_chunk_size_ = std::max(next_chunk_size_, reserved_);
+    while (chunks_) {
+      Chunk* previous = chunks_->previous;
+      ::operator delete(chunks_);
+      chunks_ = previous;
+    }
+    reserved_ = 0;
+    end_ = nullptr;
+  }
+  current_ = chunk_begin();
+  used_before_current_ = 0;
+}
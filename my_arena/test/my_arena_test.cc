@@ -0,0 +1,225 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "my_arena.h"
+#include "my_arena_offset_ptr.h"
+#include "my_shared_ptr.h"
+
+namespace {
+
+// Records the order in which objects are destroyed.
+class TestObject {
+ public:
+  TestObject(std::vector<int>& log, int id) : log_(log), id_(id) {}
+  ~TestObject() { log_.push_back(id_); }
+
+ private:
+  std::vector<int>& log_;
+  int id_;
+};
+
+struct Point {
+  int64_t x;
+  int64_t y;
+};
+
+}  // namespace
+
+TEST(MyArenaTest, AllocatesAligned) {
+  MyArena arena;
+  for (size_t align : {1, 2, 8, 16, 64, 256}) {
+    arena.allocate(1, 1);
+    void* memory = arena.allocate(24, align);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(memory) % align, 0u);
+  }
+}
+
+TEST(MyArenaTest, GrowsByChunks) {
+  MyArena arena(256);
+  std::vector<Point*> points;
+  for (int64_t i = 0; i < 1000; ++i) {
+    points.push_back(arena.create<Point>(Point{i, -i}));
+  }
+  for (int64_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(points[i]->x, i);
+    EXPECT_EQ(points[i]->y, -i);
+  }
+  EXPECT_EQ(arena.bytes_used(), 1000 * sizeof(Point));
+  EXPECT_GE(arena.bytes_reserved(), arena.bytes_used());
+}
+
+TEST(MyArenaTest, OversizedAllocation) {
+  MyArena arena(256);
+  char* big = static_cast<char*>(arena.allocate(MyArena::kMaxChunkSize * 2, 1));
+  big[MyArena::kMaxChunkSize * 2 - 1] = 'x';
+  EXPECT_GE(arena.bytes_reserved(), MyArena::kMaxChunkSize * 2);
+}
+
+TEST(MyArenaTest, SizesThatWouldWrapAreRejected) {
+  MyArena arena(256);
+  arena.allocate(1, 1);
+  // SIZE_MAX plus the padding to a 16-byte boundary wraps around to a size that would fit.
+  EXPECT_THROW(arena.allocate(SIZE_MAX, 16), std::bad_alloc);
+  MyArena single(MyArena::SingleChunk(), 256);
+  single.allocate(1, 1);
+  EXPECT_THROW(single.allocate(SIZE_MAX, 16), std::bad_alloc);
+  EXPECT_EQ(single.bytes_used(), 1u);
+}
+
+TEST(MyArenaTest, ResetSettlesOnOneChunk) {
+  MyArena arena(256);
+  auto round = [&arena] {
+    Point* first = arena.create<Point>();
+    for (int i = 0; i < 100; ++i) {
+      arena.create<Point>();
+    }
+    arena.reset();
+    return first;
+  };
+  round();
+  EXPECT_EQ(arena.bytes_used(), 0u);
+  Point* second = round();
+  size_t reserved = arena.bytes_reserved();
+  EXPECT_GE(reserved, 101 * sizeof(Point));
+  // From now on every round fits the one chunk and starts at its beginning.
+  EXPECT_EQ(round(), second);
+  EXPECT_EQ(arena.bytes_reserved(), reserved);
+}
+
+TEST(MyArenaTest, SingleChunkNeverGrows) {
+  MyArena arena(MyArena::SingleChunk(), 1024);
+  EXPECT_EQ(arena.bytes_reserved(), 1024u);
+  char* first = static_cast<char*>(arena.allocate(512, 1));
+  char* second = static_cast<char*>(arena.allocate(512, 1));
+  EXPECT_EQ(second, first + 512);
+  EXPECT_THROW(arena.allocate(1, 1), std::bad_alloc);
+  arena.reset();
+  EXPECT_EQ(arena.allocate(1024, 1), first);
+  EXPECT_EQ(arena.bytes_reserved(), 1024u);
+}
+
+TEST(MyArenaTest, CreateRunsDestructorsOnResetInReverseOrder) {
+  std::vector<int> log;
+  MyArena arena;
+  arena.create<TestObject>(log, 1);
+  arena.create<TestObject>(log, 2);
+  arena.create<TestObject>(log, 3);
+  EXPECT_TRUE(log.empty());
+  arena.reset();
+  EXPECT_EQ(log, (std::vector<int>{3, 2, 1}));
+  arena.reset();
+  EXPECT_EQ(log.size(), 3u);
+
+  {
+    MyArena scoped;
+    scoped.create<TestObject>(log, 4);
+  }
+  EXPECT_EQ(log.back(), 4);
+}
+
+TEST(MyArenaTest, TriviallyDestructibleTypesAreNotRecorded) {
+  MyArena arena;
+  arena.create<Point>();
+  EXPECT_EQ(arena.bytes_used(), sizeof(Point));
+
+  std::vector<int> log;
+  MyArena recorded;
+  recorded.create<TestObject>(log, 1);
+  EXPECT_GT(recorded.bytes_used(), sizeof(TestObject));
+}
+
+TEST(MyArenaTest, ArenaPtrRunsDestructorAtEndOfScope) {
+  static_assert(sizeof(MyArenaPtr<Point>) == sizeof(Point*), "MyArenaDeleter must take no space");
+  std::vector<int> log;
+  MyArena arena;
+  {
+    MyArenaPtr<TestObject> object = MakeMyArenaPtr<TestObject>(arena, log, 7);
+    EXPECT_TRUE(log.empty());
+  }
+  EXPECT_EQ(log, std::vector<int>{7});
+  size_t used = arena.bytes_used();
+  arena.reset();
+  EXPECT_EQ(log, std::vector<int>{7});
+  EXPECT_GE(used, sizeof(TestObject));
+}
+
+TEST(MyArenaTest, AllocatorForContainersAndSharedPointers) {
+  MyArena arena;
+  std::vector<std::string, MyArenaAllocator<std::string>> strings{MyArenaAllocator<std::string>(arena)};
+  for (int i = 0; i < 100; ++i) {
+    strings.push_back(std::to_string(i));
+  }
+  EXPECT_EQ(strings[42], "42");
+  EXPECT_GT(arena.bytes_used(), 100 * sizeof(std::string));
+
+  size_t before = arena.bytes_used();
+  MySharedPtr<Point> point = AllocateMyShared<Point>(MyArenaAllocator<Point>(arena), Point{1, 2});
+  EXPECT_EQ(point->y, 2);
+  EXPECT_GT(arena.bytes_used(), before);
+}
+
+namespace {
+
+struct ListNode {
+  ListNode(std::vector<int>& log, int id) : log(log), id(id) {}
+  ~ListNode() { log.push_back(id); }
+  std::vector<int>& log;
+  int id;
+  MyArenaOffsetPtr<ListNode> next;
+};
+
+}  // namespace
+
+TEST(MyArenaOffsetPtrTest, LinksObjectsInAnArena) {
+  static_assert(sizeof(MyArenaOffsetPtr<ListNode>) == 4, "an offset pointer is 32 bits");
+  std::vector<int> log;
+  MyArena arena(MyArena::SingleChunk(), 1 << 16);
+  {
+    MyArenaPtr<ListNode> head = MakeMyArenaPtr<ListNode>(arena, log, 0);
+    ListNode* tail = head.get();
+    for (int i = 1; i < 100; ++i) {
+      tail = &tail->next.emplace(arena, log, i);
+    }
+    int count = 0;
+    for (ListNode* node = head.get(); node; node = node->next.get()) {
+      EXPECT_EQ(node->id, count++);
+    }
+    EXPECT_EQ(count, 100);
+    EXPECT_TRUE(log.empty());
+  }
+  // Destroying the head destroyed the whole chain, front to back.
+  ASSERT_EQ(log.size(), 100u);
+  EXPECT_EQ(log.front(), 0);
+  EXPECT_EQ(log.back(), 99);
+}
+
+TEST(MyArenaOffsetPtrTest, MoveResetAndRelease) {
+  std::vector<int> log;
+  MyArena arena(MyArena::SingleChunk(), 4096);
+  ListNode* first = arena.create<ListNode>(log, 1);
+  first->next.emplace(arena, log, 2);
+  ListNode* second = arena.create<ListNode>(log, 3);
+  second->next = std::move(first->next);
+  EXPECT_FALSE(first->next);
+  EXPECT_EQ(second->next->id, 2);
+
+  second->next.reset();
+  EXPECT_EQ(log, std::vector<int>{2});
+  second->next.emplace(arena, log, 4);
+  ListNode* released = second->next.release();
+  EXPECT_FALSE(second->next);
+  EXPECT_EQ(released->id, 4);
+  EXPECT_EQ(log, std::vector<int>{2});
+}
+
+TEST(MyArenaOffsetPtrTest, RejectsFarObjects) {
+  std::vector<int> log;
+  MyArena arena(MyArena::SingleChunk(), 4096);
+  // An address 4 GB past the pointer; it is never dereferenced.
+  ListNode* near = arena.create<ListNode>(log, 1);
+  ListNode* far = reinterpret_cast<ListNode*>(reinterpret_cast<intptr_t>(&near->next) + (intptr_t{1} << 32));
+  EXPECT_THROW(near->next.reset(far), std::length_error);
+  EXPECT_FALSE(near->next);
+}
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "my_box.h"
+#include "my_unique_ptr.h"
+
+namespace {
+
+// Request handlers of the sizes we see in practice, all under 48 bytes.
+class Handler {
+ public:
+  virtual ~Handler() = default;
+  virtual int64_t handle(int64_t request) const = 0;
+};
+
+class Echo : public Handler {
+ public:
+  int64_t handle(int64_t request) const override { return request; }
+};
+
+class Scale : public Handler {
+ public:
+  explicit Scale(int64_t factor) : factor_(factor) {}
+  int64_t handle(int64_t request) const override { return request * factor_; }
+
+ private:
+  int64_t factor_;
+};
+
+class Clamp : public Handler {
+ public:
+  Clamp(int64_t low, int64_t high) : low_(low), high_(high) {}
+  int64_t handle(int64_t request) const override {
+    return request < low_ ? low_ : request > high_ ? high_ : request;
+  }
+
+ private:
+  int64_t low_;
+  int64_t high_;
+};
+
+class Route : public Handler {
+ public:
+  explicit Route(int64_t seed) : targets_{seed, seed + 1, seed + 2, seed + 3} {}
+  int64_t handle(int64_t request) const override { return targets_[request & 3]; }
+
+ private:
+  int64_t targets_[4];
+};
+
+// Makes state.range(0) handlers of random types with Make<T>(args...), in the random order in
+// which handlers get registered.
+template<typename Pointer, typename Make>
+std::vector<Pointer> MakeHandlers(int64_t count, Make make) {
+  std::vector<Pointer> handlers;
+  handlers.reserve(static_cast<size_t>(count));
+  std::mt19937_64 rng(42);
+  for (int64_t i = 0; i < count; ++i) {
+    switch (rng() % 4) {
+      case 0: handlers.push_back(make(Echo())); break;
+      case 1: handlers.push_back(make(Scale(i))); break;
+      case 2: handlers.push_back(make(Clamp(-i, i))); break;
+      default: handlers.push_back(make(Route(i))); break;
+    }
+  }
+  return handlers;
+}
+
+// Dispatches to every handler in a different order from the one they were made in, as when they
+// were registered over time: heap objects then sit scattered in memory relative to the
+// dispatch order, while inline ones move with their MyBox.
+template<typename Pointer, typename Make>
+void RunDispatch(benchmark::State& state, Make make) {
+  std::vector<Pointer> handlers = MakeHandlers<Pointer>(state.range(0), make);
+  std::mt19937_64 rng(7);
+  std::shuffle(handlers.begin(), handlers.end(), rng);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (const Pointer& handler : handlers) {
+      sum += handler->handle(sum & 0xff);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename Pointer, typename Make>
+void RunCreate(benchmark::State& state, Make make) {
+  for (auto _ : state) {
+    std::vector<Pointer> handlers = MakeHandlers<Pointer>(state.range(0), make);
+    benchmark::DoNotOptimize(handlers.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+struct MakeUnique {
+  template<typename T>
+  MyUniquePtr<Handler> operator()(T&& handler) const {
+    return MyUniquePtr<Handler>(new T(std::forward<T>(handler)));
+  }
+};
+
+struct MakeBox {
+  template<typename T>
+  MyBox<Handler> operator()(T&& handler) const {
+    return MakeMyBox<Handler, T>(std::forward<T>(handler));
+  }
+};
+
+void BM_DispatchMyUniquePtr(benchmark::State& state) {
+  RunDispatch<MyUniquePtr<Handler>>(state, MakeUnique());
+}
+
+void BM_DispatchMyBox(benchmark::State& state) {
+  RunDispatch<MyBox<Handler>>(state, MakeBox());
+}
+
+void BM_CreateMyUniquePtr(benchmark::State& state) {
+  RunCreate<MyUniquePtr<Handler>>(state, MakeUnique());
+}
+
+void BM_CreateMyBox(benchmark::State& state) {
+  RunCreate<MyBox<Handler>>(state, MakeBox());
+}
+
+constexpr int64_t kHandlers = 1'000'000;
+
+BENCHMARK(BM_DispatchMyUniquePtr)->Arg(kHandlers)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DispatchMyBox)->Arg(kHandlers)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CreateMyUniquePtr)->Arg(kHandlers)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CreateMyBox)->Arg(kHandlers)->Unit(benchmark::kMillisecond);
+
+}  // namespace
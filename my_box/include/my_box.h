@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "my_trivially_relocatable.h"
+#include "my_unique_ptr.h"
+
+/**
+ * @brief An owning pointer to a polymorphic object that keeps small objects inside itself.
+ *
+ * A derived object of up to InlineBytes bytes, with at most the alignment of std::max_align_t
+ * and a non-throwing move constructor, is constructed in a buffer inside the MyBox: no heap
+ * allocation, and the object shares a cache line with the pointer to it. Anything bigger goes to
+ * the heap, as with MyUniquePtr<Base>. Either way, get() is one load.
+ *
+ * Moving a MyBox moves the object it holds inline through a type-erased relocate operation chosen
+ * when the object was created; it is a memcpy for types that are MyIsTriviallyRelocatable. A heap
+ * object is not touched, only its pointer moves. The moved-from MyBox is empty.
+ *
+ * Unlike MyUniquePtr, there is no release(): an inline object has no heap memory to hand out.
+ *
+ * @tparam Base The type the object is accessed as. Objects are destroyed through their own type,
+ * so Base needs no virtual destructor.
+ * @tparam InlineBytes The size of the inline buffer.
+ */
+template<typename Base, size_t InlineBytes = 48>
+class MyBox {
+public:
+  /**
+   * @brief Tells whether a Derived object is stored inline rather than on the heap.
+   */
+  template<typename Derived>
+  static constexpr bool kFitsInline = sizeof(Derived) <= InlineBytes &&
+                                      alignof(Derived) <= alignof(std::max_align_t) &&
+                                      std::is_nothrow_move_constructible_v<Derived>;
+
+  /**
+   * @brief Constructs an empty MyBox.
+   */
+  MyBox() noexcept = default;
+
+  /**
+   * @brief Takes ownership of a heap object from a MyUniquePtr. The object stays on the heap.
+   *
+   * @tparam Derived A type whose pointer converts implicitly to Base*.
+   * @param object The object to take over; it is left empty.
+   */
+  template<typename Derived, typename = std::enable_if_t<std::is_convertible_v<Derived*, Base*>>>
+  MyBox(MyUniquePtr<Derived>&& object) noexcept {
+    if (object) {
+      ops_ = &kHeapOps<Derived>;
+      ptr_ = object.release();
+    }
+  }
+
+  MyBox(const MyBox&) = delete;
+  MyBox& operator=(const MyBox&) = delete;
+
+  /**
+   * @brief Move constructor. Relocates an inline object into this MyBox, or takes over the pointer
+   * to a heap object.
+   *
+   * @param other The MyBox instance to move from; it is left empty.
+   */
+  MyBox(MyBox&& other) noexcept {
+    take(other);
+  }
+
+  /**
+   * @brief Move assignment operator. Destroys the current object first.
+   *
+   * @param other The MyBox instance to move from; it is left empty.
+   * @return A reference to the updated MyBox.
+   */
+  MyBox& operator=(MyBox&& other) noexcept {
+    if (this != &other) {
+      reset();
+      take(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Destroys the object, and frees it if it is on the heap.
+   */
+  ~MyBox() {
+    reset();
+  }
+
+  /**
+   * @brief Destroys the current object, if any, and constructs a Derived in its place.
+   *
+   * @tparam Derived The type of the object to create; its pointer must convert to Base*.
+   * @param args Arguments forwarded to the constructor of Derived.
+   * @return A reference to the new object.
+   */
+  template<typename Derived, typename... Args>
+  Derived& emplace(Args&&... args) {
+    static_assert(std::is_convertible_v<Derived*, Base*>, "Derived must derive from Base");
+    reset();
+    Derived* object;
+    if constexpr (kFitsInline<Derived>) {
+      object = ::new (static_cast<void*>(buffer_)) Derived(std::forward<Args>(args)...);
+      ops_ = &kInlineOps<Derived>;
+    } else {
+      object = new Derived(std::forward<Args>(args)...);
+      ops_ = &kHeapOps<Derived>;
+    }
+    ptr_ = object;
+    return *object;
+  }
+
+  /**
+   * @brief Destroys the object, leaving the MyBox empty.
+   */
+  void reset() noexcept {
+    if (ops_) {
+      ops_->destroy(ptr_);
+      ops_ = nullptr;
+      ptr_ = nullptr;
+    }
+  }
+
+  /**
+   * @brief Checks whether the object lives in the inline buffer.
+   */
+  bool is_inline() const noexcept {
+    return ops_ && ops_->relocate;
+  }
+
+  Base* get() const noexcept {
+    return ptr_;
+  }
+
+  Base& operator*() const noexcept {
+    return *ptr_;
+  }
+
+  Base* operator->() const noexcept {
+    return ptr_;
+  }
+
+  explicit operator bool() const noexcept {
+    return ptr_ != nullptr;
+  }
+
+private:
+  /**
+   * @brief What a MyBox needs to know about the type of the object it holds.
+   */
+  struct Ops {
+    /**
+     * @brief Destroys the object, given the Base* of it, and frees it if it is on the heap.
+     */
+    void (*destroy)(Base* object) noexcept;
+
+    /**
+     * @brief Moves an inline object to the buffer at destination, destroys the original and
+     * returns the Base* of the new one. Null for heap objects, which never move.
+     */
+    Base* (*relocate)(Base* object, void* destination) noexcept;
+  };
+
+  template<typename Derived>
+  static void destroy_inline(Base* object) noexcept {
+    static_cast<Derived*>(object)->~Derived();
+  }
+
+  template<typename Derived>
+  static void destroy_heap(Base* object) noexcept {
+    delete static_cast<Derived*>(object);
+  }
+
+  template<typename Derived>
+  static Base* relocate_inline(Base* object, void* destination) noexcept {
+    Derived* source = static_cast<Derived*>(object);
+    if constexpr (MyIsTriviallyRelocatableV<Derived>) {
+      MyRelocate(source, 1, static_cast<Derived*>(destination));
+      return std::launder(static_cast<Derived*>(destination));
+    } else {
+      Derived* moved = ::new (destination) Derived(std::move(*source));
+      source->~Derived();
+      return moved;
+    }
+  }
+
+  template<typename Derived>
+  static constexpr Ops kInlineOps{&destroy_inline<Derived>, &relocate_inline<Derived>};
+
+  template<typename Derived>
+  static constexpr Ops kHeapOps{&destroy_heap<Derived>, nullptr};
+
+  void take(MyBox& other) noexcept {
+    if (other.ops_ && other.ops_->relocate) {
+      ptr_ = other.ops_->relocate(other.ptr_, buffer_);
+    } else {
+      ptr_ = other.ptr_;
+    }
+    ops_ = other.ops_;
+    other.ops_ = nullptr;
+    other.ptr_ = nullptr;
+  }
+
+  Base* ptr_ = nullptr;       ///< The object, in buffer_ or on the heap.
+  const Ops* ops_ = nullptr;  ///< How to destroy and move the object; null when empty.
+  alignas(std::max_align_t) unsigned char buffer_[InlineBytes];  ///< Holds an inline object.
+};
+
+/**
+ * @brief Creates a Derived object in a new MyBox<Base>, inline if it fits.
+ *
+ * @tparam Base The type the object is accessed as.
+ * @tparam Derived The type of the object to create.
+ * @tparam InlineBytes The size of the inline buffer.
+ * @param args Arguments forwarded to the constructor of Derived.
+ * @return A MyBox owning the new object.
+ */
+template<typename Base, typename Derived, size_t InlineBytes = 48, typename... Args>
+MyBox<Base, InlineBytes> MakeMyBox(Args&&... args) {
+  MyBox<Base, InlineBytes> box;
+  box.template emplace<Derived>(std::forward<Args>(args)...);
+  return box;
+}
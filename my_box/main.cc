@@ -0,0 +1,65 @@
+#include <iostream>
+#include "my_box.h"
+
+/**
+ * @brief A base class for the test objects of MyBox.
+ */
+class Shape {
+ public:
+  virtual ~Shape() = default;
+  virtual const char* name() const = 0;
+};
+
+/**
+ * @brief A small shape, which MyBox stores inline.
+ */
+class Circle : public Shape {
+ public:
+  Circle() {
+    std::cout << "Circle constructor" << std::endl;
+  }
+
+  ~Circle() override {
+    std::cout << "Circle destructor" << std::endl;
+  }
+
+  const char* name() const override {
+    return "circle";
+  }
+
+ private:
+  double radius_ = 1.0;
+};
+
+/**
+ * @brief A shape too big for the inline buffer, which MyBox puts on the heap.
+ */
+class Polygon : public Shape {
+ public:
+  Polygon() {
+    std::cout << "Polygon constructor" << std::endl;
+  }
+
+  ~Polygon() override {
+    std::cout << "Polygon destructor" << std::endl;
+  }
+
+  const char* name() const override {
+    return "polygon";
+  }
+
+ private:
+  double vertices_[16] = {};
+};
+
+int main() {
+  MyBox<Shape> box1 = MakeMyBox<Shape, Circle>();
+  std::cout << "box1 holds a " << box1->name() << (box1.is_inline() ? " inline" : " on the heap") << std::endl;
+  MyBox<Shape> box2 = MakeMyBox<Shape, Polygon>();
+  std::cout << "box2 holds a " << box2->name() << (box2.is_inline() ? " inline" : " on the heap") << std::endl;
+  std::cout << "--------------------------------" << std::endl;
+
+  MyBox<Shape> box3 = std::move(box1);
+  std::cout << "box1 " << (box1 ? "has" : "does not have") << " an object" << std::endl;
+  std::cout << "box3 holds a " << box3->name() << std::endl;
+}
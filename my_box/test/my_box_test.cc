@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "my_box.h"
+#include "my_string.h"
+
+namespace {
+
+class Handler {
+ public:
+  static int instance_count;
+  Handler() { ++instance_count; }
+  Handler(const Handler&) noexcept { ++instance_count; }
+  virtual ~Handler() { --instance_count; }
+  virtual int handle(int value) const = 0;
+};
+
+int Handler::instance_count = 0;
+
+class Add : public Handler {
+ public:
+  explicit Add(int amount) : amount_(amount) {}
+  int handle(int value) const override { return value + amount_; }
+
+ private:
+  int amount_;
+};
+
+// Too big for the default inline buffer.
+class Table : public Handler {
+ public:
+  Table() {
+    for (int i = 0; i < 32; ++i) {
+      table_[i] = i * i;
+    }
+  }
+  int handle(int value) const override { return table_[value % 32]; }
+
+ private:
+  int table_[32];
+};
+
+// Points into itself, so it must be relocated with its move constructor.
+class SelfReferential : public Handler {
+ public:
+  explicit SelfReferential(int value) : value_(value), self_(&value_) {}
+  SelfReferential(SelfReferential&& other) noexcept : Handler(other), value_(other.value_), self_(&value_) {}
+  int handle(int) const override { return self_ == &value_ ? value_ : -1; }
+
+ private:
+  int value_;
+  const int* self_;
+};
+
+// Holds a trivially relocatable member, so relocation is a memcpy.
+class Greeter : public Handler {
+ public:
+  using is_trivially_relocatable = std::true_type;
+  explicit Greeter(const char* name) : name_(name) {}
+  int handle(int) const override { return static_cast<int>(name_.length()); }
+
+ private:
+  MyString name_;
+};
+
+}  // namespace
+
+TEST(MyBoxTest, SmallObjectsAreInline) {
+  static_assert(sizeof(MyBox<Handler>) == 64, "48 inline bytes plus two pointers");
+  static_assert(MyBox<Handler>::kFitsInline<Add>);
+  static_assert(!MyBox<Handler>::kFitsInline<Table>);
+  {
+    MyBox<Handler> box = MakeMyBox<Handler, Add>(2);
+    EXPECT_TRUE(box.is_inline());
+    EXPECT_EQ(box->handle(40), 42);
+    EXPECT_GE(reinterpret_cast<const char*>(box.get()), reinterpret_cast<const char*>(&box));
+    EXPECT_LT(reinterpret_cast<const char*>(box.get()), reinterpret_cast<const char*>(&box + 1));
+    EXPECT_EQ(Handler::instance_count, 1);
+  }
+  EXPECT_EQ(Handler::instance_count, 0);
+}
+
+TEST(MyBoxTest, LargeObjectsGoToTheHeap) {
+  {
+    MyBox<Handler> box = MakeMyBox<Handler, Table>();
+    EXPECT_FALSE(box.is_inline());
+    EXPECT_EQ(box->handle(5), 25);
+    Handler* object = box.get();
+    MyBox<Handler> moved(std::move(box));
+    EXPECT_EQ(moved.get(), object);
+    EXPECT_FALSE(box);
+  }
+  EXPECT_EQ(Handler::instance_count, 0);
+}
+
+TEST(MyBoxTest, MoveRelocatesInlineObjects) {
+  {
+    MyBox<Handler> first = MakeMyBox<Handler, SelfReferential>(7);
+    MyBox<Handler> second(std::move(first));
+    EXPECT_FALSE(first);
+    EXPECT_EQ(second->handle(0), 7);
+    MyBox<Handler> third = MakeMyBox<Handler, Greeter>("hello");
+    third = std::move(second);
+    EXPECT_EQ(third->handle(0), 7);
+    EXPECT_EQ(Handler::instance_count, 1);
+
+    MyBox<Handler> greeter = MakeMyBox<Handler, Greeter>("hello");
+    MyBox<Handler> relocated(std::move(greeter));
+    EXPECT_EQ(relocated->handle(0), 5);
+    EXPECT_EQ(Handler::instance_count, 2);
+  }
+  EXPECT_EQ(Handler::instance_count, 0);
+}
+
+TEST(MyBoxTest, EmplaceAndReset) {
+  MyBox<Handler> box;
+  EXPECT_FALSE(box);
+  Add& add = box.emplace<Add>(1);
+  EXPECT_EQ(&add, box.get());
+  box.emplace<Table>();
+  EXPECT_EQ(Handler::instance_count, 1);
+  box.reset();
+  EXPECT_FALSE(box);
+  EXPECT_EQ(Handler::instance_count, 0);
+}
+
+TEST(MyBoxTest, AdoptsMyUniquePtr) {
+  MyUniquePtr<Add> add(new Add(3));
+  MyBox<Handler> box(std::move(add));
+  EXPECT_FALSE(add);
+  EXPECT_FALSE(box.is_inline());
+  EXPECT_EQ(box->handle(1), 4);
+}
+
+TEST(MyBoxTest, CustomInlineSize) {
+  MyBox<Handler, 256> box = MakeMyBox<Handler, Table, 256>();
+  EXPECT_TRUE(box.is_inline());
+  EXPECT_EQ(box->handle(3), 9);
+}
@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "allocation_counter.h"
+#include "my_cord.h"
+
+namespace {
+
+// count fragments of 1 to 199 characters, 100 on average, cut from a shared 1 MB text, so that
+// building a document from them measures only the document.
+std::vector<MyStringView> MakeFragments(int64_t count) {
+  static const MyString text = []() {
+    MyString text;
+    text.reserve(1 << 20);
+    std::mt19937 rng(3);
+    char word[8];
+    while (text.length() < (1 << 20) - sizeof(word)) {
+      for (char& c : word) {
+        c = static_cast<char>('a' + rng() % 26);
+      }
+      word[sizeof(word) - 1] = ' ';
+      text.append(MyStringView(word, sizeof(word)));
+    }
+    return text;
+  }();
+  std::vector<MyStringView> fragments;
+  fragments.reserve(static_cast<size_t>(count));
+  std::mt19937 rng(5);
+  for (int64_t i = 0; i < count; ++i) {
+    size_t length = 1 + rng() % 199;
+    fragments.push_back(text.substr_view(rng() % (text.length() - length), length));
+  }
+  return fragments;
+}
+
+// How a document is grown by one fragment at its end or at its front.
+struct StringAppend {
+  using Document = MyString;
+  static void add(MyString& document, MyStringView fragment) { document.append(fragment); }
+};
+
+struct CordAppend {
+  using Document = MyCord;
+  static void add(MyCord& document, MyStringView fragment) { document.append(fragment); }
+};
+
+// MyString has no prepend, so a new string is built each time, which is quadratic.
+struct StringPrepend {
+  using Document = MyString;
+  static void add(MyString& document, MyStringView fragment) { document = MyString(fragment) + document; }
+};
+
+struct CordPrepend {
+  using Document = MyCord;
+  static void add(MyCord& document, MyStringView fragment) { document.prepend(fragment); }
+};
+
+// Builds a document from state.range(0) fragments and destroys it, reporting "allocs/fragment".
+// With Flatten, a cord is copied into one MyString at the end, as for an API that needs
+// contiguous text.
+template<typename Builder, bool Flatten = false>
+void BM_BuildDocument(benchmark::State& state) {
+  std::vector<MyStringView> fragments = MakeFragments(state.range(0));
+  int64_t bytes = 0;
+  size_t before = ThreadAllocationCount();
+  for (auto _ : state) {
+    typename Builder::Document document;
+    for (MyStringView fragment : fragments) {
+      Builder::add(document, fragment);
+    }
+    if constexpr (Flatten) {
+      MyString flat = document.flatten();
+      benchmark::DoNotOptimize(flat.c_str());
+    }
+    benchmark::DoNotOptimize(&document);
+    bytes = static_cast<int64_t>(document.length());
+  }
+  state.counters["allocs/fragment"] = benchmark::Counter(
+      static_cast<double>(ThreadAllocationCount() - before) / static_cast<double>(state.iterations() * state.range(0)));
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+// Cuts 1 MB slices at state.range(0) positions spread over a 100 MB document.
+template<typename Document>
+void BM_Slice(benchmark::State& state) {
+  constexpr size_t kSlice = 1 << 20;
+  std::vector<MyStringView> fragments = MakeFragments(1'000'000);
+  Document document;
+  for (MyStringView fragment : fragments) {
+    document.append(fragment);
+  }
+  size_t step = (document.length() - kSlice) / static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      Document slice = document.substr(static_cast<size_t>(i) * step, kSlice);
+      benchmark::DoNotOptimize(&slice);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+constexpr int64_t kFragments = 1'000'000;  // About 100 MB of text
+constexpr int64_t kQuadraticFragments = 2'000;
+
+BENCHMARK_TEMPLATE(BM_BuildDocument, StringAppend)->Arg(kFragments)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BuildDocument, CordAppend)->Arg(kFragments)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BuildDocument, CordAppend, true)->Arg(kFragments)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BuildDocument, StringPrepend)->Arg(kQuadraticFragments)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BuildDocument, CordPrepend)->Arg(kQuadraticFragments)->Arg(kFragments)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Slice, MyString)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Slice, MyCord)->Arg(100)->Unit(benchmark::kMillisecond);
+
+}  // namespace
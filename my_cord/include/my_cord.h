@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include "my_intrusive_ptr.h"
+#include "my_string.h"
+#include "my_string_view.h"
+
+/**
+ * @brief A rope: a string kept as a sequence of pieces of shared, reference-counted MyString
+ * chunks, for text that is built up from many fragments or cut into large slices.
+ *
+ * Appending and prepending never move the characters already in the cord. Small fragments are
+ * copied into the chunk at the matching end, as long as that chunk belongs to this cord alone
+ * and has room (chunks hold kChunkSize characters). Larger fragments, and MyString values moved
+ * in, become chunks of their own. Either way the cost is proportional to the fragment, not to
+ * the cord.
+ *
+ * Copying a cord, taking a substring of it, or appending one cord to another shares the chunks
+ * instead of copying their characters. A shared chunk is never written to again, so every cord
+ * sees the text it was given. Pieces are kept in a deque with their position, so finding the
+ * piece holding a character is a binary search.
+ *
+ * for_each_chunk() walks the pieces in order, which is what a scatter/gather write such as
+ * writev() needs. flatten() copies the whole text into one MyString when contiguous storage is
+ * required.
+ *
+ * Like MyString, a cord is not synchronized: several threads may read one cord, or copies
+ * sharing the same chunks, but a cord must not be modified while another thread uses it.
+ */
+class MyCord {
+public:
+  static constexpr size_t npos = MyStringView::npos;
+  static constexpr size_t kChunkSize = 4096;  ///< Capacity of the chunks small fragments are packed into.
+
+  /**
+   * @brief Constructs an empty cord.
+   */
+  MyCord() = default;
+
+  /**
+   * @brief Constructs a cord holding a copy of view.
+   */
+  explicit MyCord(MyStringView view);
+
+  /**
+   * @brief Constructs a cord holding a copy of a C-style string.
+   */
+  explicit MyCord(const char* str) : MyCord(MyStringView(str)) {}
+
+  /**
+   * @brief Constructs a cord that takes over str, without copying its characters unless it
+   * is short.
+   */
+  explicit MyCord(MyString&& str);
+
+  /**
+   * @brief Copy constructor. Shares other's chunks.
+   *
+   * @param other The MyCord instance to copy from.
+   */
+  MyCord(const MyCord& other) = default;
+
+  /**
+   * @brief Move constructor. Takes over other's pieces, leaving it in a valid but empty state.
+   *
+   * @param other The MyCord instance to move from.
+   */
+  MyCord(MyCord&& other);
+
+  /**
+   * @brief Copy assignment operator. Shares other's chunks.
+   *
+   * @param other The MyCord instance to copy from.
+   * @return Reference to this object.
+   */
+  MyCord& operator=(const MyCord& other) = default;
+
+  /**
+   * @brief Move assignment operator. Takes over other's pieces, leaving it in a valid but empty
+   * state.
+   *
+   * @param other The MyCord instance to move from.
+   * @return Reference to this object.
+   */
+  MyCord& operator=(MyCord&& other) noexcept;
+
+  /**
+   * @brief Retrieves the number of characters in the cord.
+   */
+  size_t length() const { return length_; }
+
+  /**
+   * @brief Checks if the cord is empty.
+   */
+  bool empty() const { return length_ == 0; }
+
+  /**
+   * @brief Retrieves the number of pieces the text is split into.
+   */
+  size_t chunk_count() const { return pieces_.size(); }
+
+  /**
+   * @brief Appends a copy of view.
+   *
+   * @return A reference to this cord.
+   */
+  MyCord& append(MyStringView view);
+
+  /**
+   * @brief Appends a copy of a C-style string.
+   *
+   * @return A reference to this cord.
+   */
+  MyCord& append(const char* str) { return append(MyStringView(str)); }
+
+  /**
+   * @brief Appends str, taking over its characters unless it is short.
+   *
+   * @return A reference to this cord.
+   */
+  MyCord& append(MyString&& str);
+
+  /**
+   * @brief Appends the text of other, sharing its chunks. Short pieces are copied instead, so
+   * that joining many small cords does not leave a piece per join.
+   *
+   * @return A reference to this cord.
+   */
+  MyCord& append(const MyCord& other);
+
+  /**
+   * @brief Inserts a copy of view at the front.
+   *
+   * @return A reference to this cord.
+   */
+  MyCord& prepend(MyStringView view);
+
+  /**
+   * @brief Inserts the text of other at the front, sharing its chunks like append().
+   *
+   * @return A reference to this cord.
+   */
+  MyCord& prepend(const MyCord& other);
+
+  /**
+   * @brief Returns a cord of a substring that shares this cord's chunks.
+   *
+   * Takes O(log pieces) to find the first piece, plus one step per piece of the result.
+   *
+   * @param pos Starting position of substring.
+   * @param len Length of substring (npos means until end of cord).
+   * @return A cord holding the substring; empty if pos is past the end.
+   */
+  MyCord substr(size_t pos, size_t len = npos) const;
+
+  /**
+   * @brief Accesses a character, in O(log pieces). No bounds checking.
+   */
+  char operator[](size_t pos) const;
+
+  /**
+   * @brief Calls f with a MyStringView of each piece, in order.
+   *
+   * The views are valid until the cord is modified or destroyed.
+   *
+   * @param f Called as `f(MyStringView)`.
+   */
+  template<typename Function>
+  void for_each_chunk(Function&& f) const {
+    for (const Piece& piece : pieces_) {
+      f(MyStringView(piece.chunk->text.c_str() + piece.offset, piece.length));
+    }
+  }
+
+  /**
+   * @brief Copies the text into a single MyString, allocated once.
+   */
+  MyString flatten() const;
+
+  /**
+   * @brief Removes all characters, letting go of the chunks.
+   */
+  void clear();
+
+private:
+  /**
+   * @brief A shared block of text. Its characters outside the pieces that use it are free
+   * space, which only the sole owner may write to.
+   */
+  struct Chunk : MyRefCounted<Chunk> {
+    explicit Chunk(MyString&& str) : text(std::move(str)) {}
+    MyString text;
+  };
+
+  /**
+   * @brief A run of characters of a chunk. start is the piece's position in a frame that does
+   * not move when the cord grows at either end: the cord's first character is at origin_, and
+   * each piece starts where the previous one ends.
+   */
+  struct Piece {
+    MyIntrusivePtr<Chunk> chunk;
+    int64_t start;
+    size_t offset;  ///< First character of the piece in the chunk.
+    size_t length;
+  };
+
+  static constexpr size_t kShareThreshold = kChunkSize / 8;  ///< Shorter pieces are copied, not shared.
+
+  static bool Unshared(const Chunk& chunk);
+  void push_back(MyIntrusivePtr<Chunk> chunk, size_t offset, size_t length);
+  void push_front(MyIntrusivePtr<Chunk> chunk, size_t offset, size_t length);
+  std::deque<Piece>::const_iterator find_piece(size_t pos) const;
+
+  std::deque<Piece> pieces_;
+  int64_t origin_ = 0;  ///< Position of the first character in the frame of Piece::start.
+  size_t length_ = 0;
+};
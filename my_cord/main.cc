@@ -0,0 +1,27 @@
+#include <sys/uio.h>
+#include <unistd.h>
+#include <iostream>
+#include <vector>
+#include "my_cord.h"
+
+int main() {
+  MyCord response("Content-Type: text/plain\r\n\r\n");
+  response.prepend("HTTP/1.1 200 OK\r\n");
+  response.append(MyString("Hello from a cord.\n"));
+  std::cout << "length: " << response.length() << ", pieces: " << response.chunk_count() << std::endl;
+  std::cout << "--------------------------------" << std::endl;
+
+  // The body is shared with the response, not copied.
+  MyCord body = response.substr(response.length() - 19);
+  std::cout << "body: " << body.flatten();
+  std::cout << "--------------------------------" << std::endl;
+
+  // Hand every piece to the kernel in one call, without flattening.
+  std::vector<iovec> pieces;
+  response.for_each_chunk([&pieces](MyStringView chunk) {
+    pieces.push_back(iovec{const_cast<char*>(chunk.data()), chunk.length()});
+  });
+  std::cout << std::flush;
+  ssize_t written = writev(STDOUT_FILENO, pieces.data(), static_cast<int>(pieces.size()));
+  std::cout << "writev wrote " << written << " bytes from " << pieces.size() << " pieces" << std::endl;
+}
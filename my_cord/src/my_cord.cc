@@ -0,0 +1,210 @@
+#include "my_cord.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// Filler for the unused front of a chunk that grows towards its start.
+const char kBlank[MyCord::kChunkSize] = {};
+
+}  // namespace
+
+// Constructors
+MyCord::MyCord(MyStringView view) {
+  append(view);
+}
+
+MyCord::MyCord(MyString&& str) {
+  append(std::move(str));
+}
+
+// Move constructor
+MyCord::MyCord(MyCord&& other)
+    : pieces_(std::move(other.pieces_)), origin_(other.origin_), length_(other.length_) {
+  other.clear();
+}
+
+// Move assignment operator
+MyCord& MyCord::operator=(MyCord&& other) noexcept {
+  if (this != &other) {
+    pieces_ = std::move(other.pieces_);
+    origin_ = other.origin_;
+    length_ = other.length_;
+    other.clear();
+  }
+  return *this;
+}
+
+// Append a copy of a view
+MyCord& MyCord::append(MyStringView view) {
+  if (view.empty()) return *this;
+  // Fill the free space at the end of the last chunk, if no one else can see it.
+  if (!pieces_.empty()) {
+    Piece& tail = pieces_.back();
+    MyString& text = tail.chunk->text;
+    if (Unshared(*tail.chunk) && tail.offset + tail.length == text.length()) {
+      size_t fits = std::min(text.capacity() - text.length(), view.length());
+      text.append(view.substr(0, fits));
+      tail.length += fits;
+      length_ += fits;
+      view.remove_prefix(fits);
+      if (view.empty()) return *this;
+    }
+  }
+  size_t length = view.length();
+  if (length >= kChunkSize) {
+    push_back(MakeMyIntrusive<Chunk>(MyString(view)), 0, length);
+  } else {
+    MyString text;
+    text.reserve(kChunkSize);
+    text.append(view);
+    push_back(MakeMyIntrusive<Chunk>(std::move(text)), 0, length);
+  }
+  return *this;
+}
+
+// Append a string, adopting its buffer
+MyCord& MyCord::append(MyString&& str) {
+  if (str.length() < kShareThreshold) {
+    return append(str.view());
+  }
+  size_t length = str.length();
+  push_back(MakeMyIntrusive<Chunk>(std::move(str)), 0, length);
+  return *this;
+}
+
+// Append another cord, sharing its chunks
+MyCord& MyCord::append(const MyCord& other) {
+  if (&other == this) {
+    MyCord copy(other);
+    return append(copy);
+  }
+  for (const Piece& piece : other.pieces_) {
+    if (piece.length < kShareThreshold) {
+      append(MyStringView(piece.chunk->text.c_str() + piece.offset, piece.length));
+    } else {
+      push_back(piece.chunk, piece.offset, piece.length);
+    }
+  }
+  return *this;
+}
+
+// Prepend a copy of a view
+MyCord& MyCord::prepend(MyStringView view) {
+  if (view.empty()) return *this;
+  // Fill the free space at the start of the first chunk, if no one else can see it.
+  if (!pieces_.empty()) {
+    Piece& head = pieces_.front();
+    if (Unshared(*head.chunk) && head.offset > 0) {
+      size_t fits = std::min(head.offset, view.length());
+      memcpy(&head.chunk->text[head.offset - fits], view.data() + view.length() - fits, fits);
+      head.offset -= fits;
+      head.length += fits;
+      head.start -= static_cast<int64_t>(fits);
+      origin_ -= static_cast<int64_t>(fits);
+      length_ += fits;
+      view.remove_suffix(fits);
+      if (view.empty()) return *this;
+    }
+  }
+  size_t length = view.length();
+  if (length >= kChunkSize) {
+    push_front(MakeMyIntrusive<Chunk>(MyString(view)), 0, length);
+  } else {
+    // The fragment goes at the end of a new chunk, leaving the front free for later prepends.
+    MyString text;
+    text.reserve(kChunkSize);
+    text.append(MyStringView(kBlank, kChunkSize - length));
+    text.append(view);
+    push_front(MakeMyIntrusive<Chunk>(std::move(text)), kChunkSize - length, length);
+  }
+  return *this;
+}
+
+// Prepend another cord, sharing its chunks
+MyCord& MyCord::prepend(const MyCord& other) {
+  if (&other == this) {
+    MyCord copy(other);
+    return prepend(copy);
+  }
+  for (auto it = other.pieces_.rbegin(); it != other.pieces_.rend(); ++it) {
+    if (it->length < kShareThreshold) {
+      prepend(MyStringView(it->chunk->text.c_str() + it->offset, it->length));
+    } else {
+      push_front(it->chunk, it->offset, it->length);
+    }
+  }
+  return *this;
+}
+
+// Extract a substring
+MyCord MyCord::substr(size_t pos, size_t len) const {
+  MyCord result;
+  if (pos >= length_) return result;
+  len = std::min(len, length_ - pos);
+  auto it = find_piece(pos);
+  size_t skip = static_cast<size_t>(origin_ + static_cast<int64_t>(pos) - it->start);
+  while (len > 0) {
+    size_t take = std::min(len, it->length - skip);
+    result.push_back(it->chunk, it->offset + skip, take);
+    len -= take;
+    skip = 0;
+    ++it;
+  }
+  return result;
+}
+
+// Access character
+char MyCord::operator[](size_t pos) const {
+  auto it = find_piece(pos);
+  size_t skip = static_cast<size_t>(origin_ + static_cast<int64_t>(pos) - it->start);
+  return it->chunk->text.c_str()[it->offset + skip];
+}
+
+// Copy into a single string
+MyString MyCord::flatten() const {
+  MyString result;
+  result.reserve(length_);
+  for_each_chunk([&result](MyStringView chunk) { result.append(chunk); });
+  return result;
+}
+
+// Clear the cord
+void MyCord::clear() {
+  pieces_.clear();
+  origin_ = 0;
+  length_ = 0;
+}
+
+// Whether this cord holds the only reference to chunk, so that it may write to its free space.
+bool MyCord::Unshared(const Chunk& chunk) {
+  if (chunk.use_count() != 1) {
+    return false;
+  }
+  // use_count() is a relaxed read. The fence pairs with the release in the decrement of the
+  // last other owner, so that its reads of the chunk happen before our writes.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return true;
+}
+
+void MyCord::push_back(MyIntrusivePtr<Chunk> chunk, size_t offset, size_t length) {
+  pieces_.push_back(Piece{std::move(chunk), origin_ + static_cast<int64_t>(length_), offset, length});
+  length_ += length;
+}
+
+void MyCord::push_front(MyIntrusivePtr<Chunk> chunk, size_t offset, size_t length) {
+  origin_ -= static_cast<int64_t>(length);
+  pieces_.push_front(Piece{std::move(chunk), origin_, offset, length});
+  length_ += length;
+}
+
+// The last piece starting at or before pos.
+std::deque<MyCord::Piece>::const_iterator MyCord::find_piece(size_t pos) const {
+  int64_t target = origin_ + static_cast<int64_t>(pos);
+  auto it = std::upper_bound(pieces_.begin(), pieces_.end(), target,
+                             [](int64_t position, const Piece& piece) { return position < piece.start; });
+  return it - 1;
+}
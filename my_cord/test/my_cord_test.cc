@@ -0,0 +1,163 @@
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+#include "my_cord.h"
+
+namespace {
+
+std::string Text(const MyCord& cord) {
+  std::string text;
+  cord.for_each_chunk([&text](MyStringView chunk) { text.append(chunk.data(), chunk.length()); });
+  return text;
+}
+
+}  // namespace
+
+TEST(MyCordTest, AppendPrependAndFlatten) {
+  MyCord cord;
+  EXPECT_TRUE(cord.empty());
+  EXPECT_EQ(cord.flatten().length(), 0u);
+
+  cord.append("world");
+  cord.prepend("hello, ");
+  cord.append(MyString("!"));
+  EXPECT_EQ(cord.length(), 13u);
+  EXPECT_STREQ(cord.flatten().c_str(), "hello, world!");
+  EXPECT_EQ(cord[0], 'h');
+  EXPECT_EQ(cord[7], 'w');
+  EXPECT_EQ(cord[12], '!');
+
+  // Small fragments are packed into chunks at either end.
+  MyCord packed;
+  for (int i = 0; i < 1000; ++i) {
+    packed.append("0123456789");
+    packed.prepend("abcdefghij");
+  }
+  EXPECT_EQ(packed.length(), 20000u);
+  EXPECT_LE(packed.chunk_count(), 6u);
+  EXPECT_EQ(packed[9999], 'j');
+  EXPECT_EQ(packed[10000], '0');
+
+  // A large string moved in keeps its buffer.
+  MyString large(std::string(10000, 'x').c_str());
+  const char* buffer = large.c_str();
+  MyCord adopted(std::move(large));
+  adopted.for_each_chunk([&](MyStringView chunk) { EXPECT_EQ(chunk.data(), buffer); });
+}
+
+TEST(MyCordTest, CopiesAndSubstringsShareChunks) {
+  std::string expected;
+  MyCord cord;
+  for (int i = 0; i < 5000; ++i) {
+    std::string fragment = "fragment " + std::to_string(i) + "\n";
+    cord.append(fragment.c_str());
+    expected += fragment;
+  }
+
+  MyCord slice = cord.substr(1000, 20000);
+  EXPECT_EQ(Text(slice), expected.substr(1000, 20000));
+  EXPECT_EQ(Text(cord.substr(expected.size() - 5)), expected.substr(expected.size() - 5));
+  EXPECT_TRUE(cord.substr(expected.size()).empty());
+
+  // The slice points into the cord's chunks rather than at copies of them.
+  const char* first = nullptr;
+  slice.for_each_chunk([&first](MyStringView chunk) {
+    if (!first) first = chunk.data();
+  });
+  const char* inside = nullptr;
+  cord.for_each_chunk([&](MyStringView chunk) {
+    if (first >= chunk.data() && first < chunk.data() + chunk.length()) inside = chunk.data();
+  });
+  EXPECT_NE(inside, nullptr);
+
+  // Growing one cord never shows up in another that shares its chunks.
+  MyCord copy = cord;
+  copy.append("tail");
+  copy.prepend("head");
+  slice.append("more");
+  slice.prepend("less");
+  EXPECT_EQ(Text(cord), expected);
+  EXPECT_EQ(Text(copy), "head" + expected + "tail");
+  EXPECT_EQ(Text(slice), "less" + expected.substr(1000, 20000) + "more");
+
+  cord.append(cord);
+  EXPECT_EQ(Text(cord), expected + expected);
+  cord.clear();
+  EXPECT_TRUE(cord.empty());
+  EXPECT_EQ(Text(copy), "head" + expected + "tail");
+}
+
+TEST(MyCordTest, MovedFromCordIsEmpty) {
+  MyCord cord("hello world");
+  MyCord moved(std::move(cord));
+  EXPECT_EQ(Text(moved), "hello world");
+  EXPECT_TRUE(cord.empty());
+  EXPECT_EQ(cord.length(), 0u);
+  EXPECT_EQ(cord.chunk_count(), 0u);
+  EXPECT_TRUE(cord.substr(2).empty());
+
+  // The moved-from cord can be used again.
+  cord.append("again");
+  EXPECT_EQ(Text(cord), "again");
+  EXPECT_EQ(cord[0], 'a');
+
+  moved = std::move(cord);
+  EXPECT_EQ(Text(moved), "again");
+  EXPECT_TRUE(cord.empty());
+  EXPECT_TRUE(cord.substr(0).empty());
+  cord.prepend("front");
+  EXPECT_EQ(Text(cord), "front");
+}
+
+TEST(MyCordTest, MatchesStdStringUnderRandomEdits) {
+  std::mt19937 rng(7);
+  std::string pool;
+  for (int i = 0; i < 20000; ++i) {
+    pool += static_cast<char>('a' + rng() % 26);
+  }
+  MyCord cord;
+  std::string expected;
+  for (int step = 0; step < 2000; ++step) {
+    size_t length = rng() % 3 == 0 ? rng() % 10000 : rng() % 100;
+    MyStringView fragment(pool.data() + rng() % (pool.size() - length), length);
+    switch (rng() % 5) {
+      case 0:
+        cord.append(fragment);
+        expected.append(fragment.data(), fragment.length());
+        break;
+      case 1:
+        cord.prepend(fragment);
+        expected.insert(0, fragment.data(), fragment.length());
+        break;
+      case 2: {
+        size_t pos = expected.empty() ? 0 : rng() % expected.size();
+        size_t len = rng() % 20000;
+        MyCord part = cord.substr(pos, len);
+        cord.append(part);
+        expected += expected.substr(pos, len);
+        break;
+      }
+      case 3: {
+        size_t pos = expected.empty() ? 0 : rng() % expected.size();
+        MyCord part = cord.substr(pos, rng() % 20000);
+        cord.prepend(part);
+        expected.insert(0, expected.substr(pos, part.length()));
+        break;
+      }
+      default:
+        if (expected.size() > 100000) {
+          size_t pos = rng() % expected.size();
+          cord = cord.substr(pos, 50000);
+          expected = expected.substr(pos, 50000);
+        }
+        break;
+    }
+    ASSERT_EQ(cord.length(), expected.size());
+    if (!expected.empty()) {
+      size_t pos = rng() % expected.size();
+      ASSERT_EQ(cord[pos], expected[pos]);
+    }
+  }
+  EXPECT_EQ(Text(cord), expected);
+  EXPECT_EQ(std::string(cord.flatten().c_str(), cord.length()), expected);
+}
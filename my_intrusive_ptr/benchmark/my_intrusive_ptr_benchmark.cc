@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "cache_miss_counter.h"
+#include "my_intrusive_ptr.h"
+#include "my_shared_ptr.h"
+
+namespace {
+
+// Graph workloads over state.range(0) nodes, each with a value and two edges. Edge 0 links all
+// nodes into one cycle in random order, so walking it visits every node with no locality; edge 1
+// points at a random node. Each *Graph struct names the pointer type under test and how to make
+// a node, like the tree benchmarks of MySharedPtr.
+template<typename Node>
+struct IntrusiveGraph {
+  using Ptr = MyIntrusivePtr<Node>;
+  static Ptr Make() { return MakeMyIntrusive<Node>(); }
+};
+
+template<typename Node>
+struct MakeMySharedGraph {
+  using Ptr = MySharedPtr<Node>;
+  static Ptr Make() { return MakeMyShared<Node>(); }
+};
+
+// A separate control block per node, as when MySharedPtr adopts objects made with new.
+template<typename Node>
+struct RawMySharedGraph {
+  using Ptr = MySharedPtr<Node>;
+  static Ptr Make() { return Ptr(new Node()); }
+};
+
+template<template<typename> class Graph>
+struct SharedNode {
+  int64_t value{0};
+  typename Graph<SharedNode>::Ptr edges[2];
+};
+
+template<typename Policy>
+struct IntrusiveNode : MyRefCounted<IntrusiveNode<Policy>, Policy> {
+  int64_t value{0};
+  MyIntrusivePtr<IntrusiveNode> edges[2];
+};
+
+template<typename Graph>
+std::vector<typename Graph::Ptr> BuildGraph(int64_t size) {
+  std::vector<typename Graph::Ptr> nodes;
+  nodes.reserve(static_cast<size_t>(size));
+  for (int64_t i = 0; i < size; ++i) {
+    nodes.push_back(Graph::Make());
+    nodes.back()->value = i;
+  }
+  std::vector<size_t> order(nodes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::mt19937_64 rng(42);
+  std::shuffle(order.begin(), order.end(), rng);
+  std::uniform_int_distribution<size_t> any(0, nodes.size() - 1);
+  for (size_t i = 0; i < order.size(); ++i) {
+    nodes[order[i]]->edges[0] = nodes[order[(i + 1) % order.size()]];
+    nodes[order[i]]->edges[1] = nodes[any(rng)];
+  }
+  return nodes;
+}
+
+// The edges form cycles, which reference counting cannot free on its own.
+template<typename Graph>
+void DestroyGraph(std::vector<typename Graph::Ptr>& nodes) {
+  for (auto& node : nodes) {
+    node->edges[0] = typename Graph::Ptr();
+    node->edges[1] = typename Graph::Ptr();
+  }
+  nodes.clear();
+}
+
+// Reports the hardware cache misses per node, when the platform lets us count them.
+class CacheMissReport {
+public:
+  void start() { counter_.start(); }
+  void stop() { misses_ += counter_.stop(); }
+
+  void report(benchmark::State& state, int64_t nodes_per_iteration) {
+    if (counter_.available()) {
+      state.counters["cache_misses/node"] = benchmark::Counter(
+          static_cast<double>(misses_) / static_cast<double>(state.iterations() * nodes_per_iteration));
+    }
+    state.SetItemsProcessed(state.iterations() * nodes_per_iteration);
+  }
+
+private:
+  CacheMissCounter counter_;
+  uint64_t misses_ = 0;
+};
+
+// Walks the cycle, copying the pointer to each next node and dropping the previous one.
+template<typename Graph>
+void BM_GraphTraverse(benchmark::State& state) {
+  std::vector<typename Graph::Ptr> nodes = BuildGraph<Graph>(state.range(0));
+  CacheMissReport misses;
+  for (auto _ : state) {
+    misses.start();
+    typename Graph::Ptr current = nodes.front();
+    int64_t sum = 0;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      sum += current->value;
+      current = current->edges[0];
+    }
+    benchmark::DoNotOptimize(sum);
+    misses.stop();
+  }
+  misses.report(state, state.range(0));
+  DestroyGraph<Graph>(nodes);
+}
+
+// Copies every node's random edge into a new vector and destroys the copies again, so each node
+// gets one increment and one decrement in random order.
+template<typename Graph>
+void BM_GraphCopy(benchmark::State& state) {
+  std::vector<typename Graph::Ptr> nodes = BuildGraph<Graph>(state.range(0));
+  std::vector<typename Graph::Ptr> copies;
+  copies.reserve(nodes.size());
+  CacheMissReport misses;
+  for (auto _ : state) {
+    misses.start();
+    for (auto& node : nodes) {
+      copies.push_back(node->edges[1]);
+    }
+    copies.clear();
+    misses.stop();
+  }
+  misses.report(state, state.range(0));
+  DestroyGraph<Graph>(nodes);
+}
+
+using AtomicIntrusive = IntrusiveGraph<IntrusiveNode<MultiThreaded>>;
+using LocalIntrusive = IntrusiveGraph<IntrusiveNode<SingleThreaded>>;
+using InlineShared = MakeMySharedGraph<SharedNode<MakeMySharedGraph>>;
+using SeparateShared = RawMySharedGraph<SharedNode<RawMySharedGraph>>;
+
+constexpr int64_t kGraphNodes = 10'000'000;
+
+BENCHMARK_TEMPLATE(BM_GraphTraverse, AtomicIntrusive)->Arg(kGraphNodes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GraphTraverse, LocalIntrusive)->Arg(kGraphNodes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GraphTraverse, InlineShared)->Arg(kGraphNodes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GraphTraverse, SeparateShared)->Arg(kGraphNodes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_GraphCopy, AtomicIntrusive)->Arg(kGraphNodes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GraphCopy, LocalIntrusive)->Arg(kGraphNodes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GraphCopy, InlineShared)->Arg(kGraphNodes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GraphCopy, SeparateShared)->Arg(kGraphNodes)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "my_shared_ptr.h"
+
+/**
+ * @brief A base class that embeds a reference count in objects managed by MyIntrusivePtr.
+ *
+ * Derive from MyRefCounted<Derived> (the curiously recurring template pattern) to make Derived
+ * usable with MyIntrusivePtr. The count lives inside the object, so there is no control block:
+ * the object is the only allocation and the count shares its cache lines. An object starts with a
+ * count of zero and is deleted through a Derived* when the last MyIntrusivePtr lets go.
+ *
+ * Because the count travels with the object, a MyIntrusivePtr can be made from a raw pointer at
+ * any time, including from `this` inside a member function, without creating a second owner.
+ *
+ * Copying or assigning a Derived object does not copy the count: the copy is a new object with no
+ * owners yet.
+ *
+ * @tparam Derived The class deriving from MyRefCounted.
+ * @tparam Policy The reference counting policy, MultiThreaded or SingleThreaded.
+ */
+template<typename Derived, typename Policy = MultiThreaded>
+class MyRefCounted {
+public:
+  /**
+   * @brief Retrieves the current number of MyIntrusivePtr owners.
+   *
+   * With the MultiThreaded policy, the value may be stale by the time it is returned.
+   */
+  size_t use_count() const noexcept {
+    return Policy::load(ref_count_);
+  }
+
+  /**
+   * @brief Adds an owner. Found by argument-dependent lookup from MyIntrusivePtr.
+   */
+  friend void MyIntrusiveAddRef(const MyRefCounted* object) noexcept {
+    Policy::increment(object->ref_count_);
+  }
+
+  /**
+   * @brief Removes an owner and deletes the object if it was the last one. Found by
+   * argument-dependent lookup from MyIntrusivePtr.
+   */
+  friend void MyIntrusiveRelease(const MyRefCounted* object) noexcept {
+    if (Policy::decrement(object->ref_count_)) {
+      delete static_cast<const Derived*>(object);
+    }
+  }
+
+protected:
+  MyRefCounted() noexcept = default;
+
+  MyRefCounted(const MyRefCounted&) noexcept {}
+
+  MyRefCounted& operator=(const MyRefCounted&) noexcept {
+    return *this;
+  }
+
+  ~MyRefCounted() = default;
+
+private:
+  mutable typename Policy::Count ref_count_{0};  ///< Number of MyIntrusivePtr instances owning the object.
+};
+
+/**
+ * @brief A shared pointer to an object that carries its own reference count.
+ *
+ * MyIntrusivePtr is one pointer wide. Copying it updates the count inside the object through the
+ * functions `MyIntrusiveAddRef(T*)` and `MyIntrusiveRelease(T*)`, found by argument-dependent
+ * lookup. MyRefCounted provides both, but any type may define its own.
+ *
+ * @tparam T The type of the object managed by this pointer.
+ */
+template<typename T>
+class MyIntrusivePtr {
+public:
+  /**
+   * @brief A single pointer, and nothing points back into it.
+   */
+  using is_trivially_relocatable = std::true_type;
+
+  /**
+   * @brief Constructs a MyIntrusivePtr that shares ownership of ptr.
+   *
+   * Adds an owner to ptr, which may already be owned by other MyIntrusivePtr instances, so this
+   * is safe for a raw `this`.
+   *
+   * @param ptr Pointer to the object to be managed (can be nullptr).
+   */
+  MyIntrusivePtr(T* ptr = nullptr) noexcept : ptr_(ptr) {
+    if (ptr_) {
+      MyIntrusiveAddRef(ptr_);
+    }
+  }
+
+  /**
+   * @brief Copy constructor. Adds an owner.
+   *
+   * @param other The MyIntrusivePtr instance to copy.
+   */
+  MyIntrusivePtr(const MyIntrusivePtr& other) noexcept : MyIntrusivePtr(other.ptr_) {}
+
+  /**
+   * @brief Converting copy constructor.
+   *
+   * @tparam U A type whose pointer converts implicitly to T*.
+   * @param other The MyIntrusivePtr instance to copy.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  MyIntrusivePtr(const MyIntrusivePtr<U>& other) noexcept : MyIntrusivePtr(other.get()) {}
+
+  /**
+   * @brief Move constructor. Takes over other's ownership without touching the count.
+   *
+   * @param other The MyIntrusivePtr instance to move from.
+   */
+  MyIntrusivePtr(MyIntrusivePtr&& other) noexcept : ptr_(other.ptr_) {
+    other.ptr_ = nullptr;
+  }
+
+  /**
+   * @brief Converting move constructor.
+   *
+   * @tparam U A type whose pointer converts implicitly to T*.
+   * @param other The MyIntrusivePtr instance to move from.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  MyIntrusivePtr(MyIntrusivePtr<U>&& other) noexcept : ptr_(other.detach()) {}
+
+  /**
+   * @brief Destroys the MyIntrusivePtr, removing an owner.
+   */
+  ~MyIntrusivePtr() {
+    if (ptr_) {
+      MyIntrusiveRelease(ptr_);
+    }
+  }
+
+  /**
+   * @brief Copy assignment operator.
+   *
+   * @param other The MyIntrusivePtr instance to assign from.
+   * @return A reference to the updated MyIntrusivePtr.
+   */
+  MyIntrusivePtr& operator=(const MyIntrusivePtr& other) noexcept {
+    MyIntrusivePtr(other).swap(*this);
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param other The MyIntrusivePtr instance to move from.
+   * @return A reference to the updated MyIntrusivePtr.
+   */
+  MyIntrusivePtr& operator=(MyIntrusivePtr&& other) noexcept {
+    MyIntrusivePtr(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  /**
+   * @brief Replaces the managed object with ptr, adding an owner to it.
+   *
+   * @param ptr The new object to share (can be nullptr).
+   */
+  void reset(T* ptr = nullptr) noexcept {
+    MyIntrusivePtr(ptr).swap(*this);
+  }
+
+  /**
+   * @brief Gives up management of the object without removing an owner.
+   *
+   * @return The object, whose count still includes the owner this instance held.
+   */
+  T* detach() noexcept {
+    T* ptr = ptr_;
+    ptr_ = nullptr;
+    return ptr;
+  }
+
+  /**
+   * @brief Exchanges the managed objects of two MyIntrusivePtr instances.
+   *
+   * @param other The MyIntrusivePtr instance to swap with.
+   */
+  void swap(MyIntrusivePtr& other) noexcept {
+    std::swap(ptr_, other.ptr_);
+  }
+
+  /**
+   * @brief Dereference operator.
+   *
+   * @return A reference to the managed object.
+   */
+  T& operator*() const noexcept {
+    return *ptr_;
+  }
+
+  /**
+   * @brief Member access operator.
+   *
+   * @return A pointer to the managed object.
+   */
+  T* operator->() const noexcept {
+    return ptr_;
+  }
+
+  /**
+   * @brief Retrieves the raw pointer to the managed object.
+   *
+   * @return A pointer to the managed object.
+   */
+  T* get() const noexcept {
+    return ptr_;
+  }
+
+  /**
+   * @brief Checks if the managed object is non-null.
+   *
+   * @return true if the managed object is non-null, false otherwise.
+   */
+  explicit operator bool() const noexcept {
+    return ptr_ != nullptr;
+  }
+
+private:
+  T* ptr_;  ///< Pointer to the managed object.
+};
+
+/**
+ * @brief Creates an object and the MyIntrusivePtr that owns it.
+ *
+ * @tparam T The type of the object to create.
+ * @param args Arguments forwarded to the constructor of T.
+ * @return A MyIntrusivePtr owning the new object.
+ */
+template<typename T, typename... Args>
+MyIntrusivePtr<T> MakeMyIntrusive(Args&&... args) {
+  return MyIntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Exchanges the managed objects of two MyIntrusivePtr instances.
+ */
+template<typename T>
+void swap(MyIntrusivePtr<T>& lhs, MyIntrusivePtr<T>& rhs) noexcept {
+  lhs.swap(rhs);
+}
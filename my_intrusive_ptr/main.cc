@@ -0,0 +1,38 @@
+#include <iostream>
+#include "my_intrusive_ptr.h"
+
+/**
+ * @brief A test class for MyIntrusivePtr.
+ *
+ * The reference count lives inside the object, inherited from MyRefCounted. It prints messages
+ * upon construction and destruction to help observe the lifecycle of the object.
+ */
+class Object : public MyRefCounted<Object> {
+ public:
+  Object() {
+    std::cout << "Object constructor" << std::endl;
+  }
+
+  ~Object() {
+    std::cout << "Object destructor" << std::endl;
+  }
+
+  /**
+   * @brief Hands out another owner of this object, straight from `this`.
+   */
+  MyIntrusivePtr<Object> self() {
+    return MyIntrusivePtr<Object>(this);
+  }
+};
+
+int main() {
+  MyIntrusivePtr<Object> ptr1 = MakeMyIntrusive<Object>();
+  std::cout << "ptr1 use_count: " << ptr1->use_count() << std::endl;
+
+  MyIntrusivePtr<Object> ptr2 = ptr1->self();
+  std::cout << "ptr2 use_count: " << ptr2->use_count() << std::endl;
+
+  ptr1.reset();
+  std::cout << "ptr2 use_count: " << ptr2->use_count() << std::endl;
+  std::cout << "sizeof(MyIntrusivePtr<Object>): " << sizeof(ptr2) << std::endl;
+}
@@ -0,0 +1,3 @@
+#include "my_intrusive_ptr.h"
+
+// For template class, all the implementation should be in the header file.
@@ -0,0 +1,133 @@
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "my_intrusive_ptr.h"
+
+// Define a test class to verify object destruction.
+class TestObject : public MyRefCounted<TestObject> {
+ public:
+  static int instances;
+  TestObject() { ++instances; }
+  TestObject(const TestObject& other) : MyRefCounted(other), value(other.value) { ++instances; }
+  TestObject& operator=(const TestObject&) = default;
+  virtual ~TestObject() { --instances; }
+
+  MyIntrusivePtr<TestObject> self() { return MyIntrusivePtr<TestObject>(this); }
+
+  int value{0};
+};
+
+int TestObject::instances = 0;
+
+class DerivedObject : public TestObject {};
+
+class LocalObject : public MyRefCounted<LocalObject, SingleThreaded> {
+ public:
+  static int instances;
+  LocalObject() { ++instances; }
+  ~LocalObject() { --instances; }
+};
+
+int LocalObject::instances = 0;
+
+TEST(MyIntrusivePtrTest, OnePointerWide) {
+  static_assert(sizeof(MyIntrusivePtr<TestObject>) == sizeof(TestObject*));
+  static_assert(sizeof(MyIntrusivePtr<LocalObject>) == sizeof(LocalObject*));
+}
+
+TEST(MyIntrusivePtrTest, NullPointer) {
+  MyIntrusivePtr<TestObject> ptr;
+  EXPECT_EQ(ptr.get(), nullptr);
+  EXPECT_FALSE(ptr);
+  MyIntrusivePtr<TestObject> copy(ptr);
+  EXPECT_FALSE(copy);
+}
+
+TEST(MyIntrusivePtrTest, CopyAndDestroy) {
+  {
+    MyIntrusivePtr<TestObject> ptr = MakeMyIntrusive<TestObject>();
+    EXPECT_EQ(ptr->use_count(), 1);
+    {
+      MyIntrusivePtr<TestObject> copy(ptr);
+      EXPECT_EQ(ptr->use_count(), 2);
+      MyIntrusivePtr<TestObject> assigned;
+      assigned = copy;
+      EXPECT_EQ(ptr->use_count(), 3);
+    }
+    EXPECT_EQ(ptr->use_count(), 1);
+    EXPECT_EQ(TestObject::instances, 1);
+  }
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MyIntrusivePtrTest, FromRawThis) {
+  MyIntrusivePtr<TestObject> ptr = MakeMyIntrusive<TestObject>();
+  MyIntrusivePtr<TestObject> self = ptr->self();
+  EXPECT_EQ(self.get(), ptr.get());
+  EXPECT_EQ(ptr->use_count(), 2);
+  ptr.reset();
+  EXPECT_EQ(TestObject::instances, 1);
+  self.reset();
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MyIntrusivePtrTest, MoveAndDetach) {
+  MyIntrusivePtr<TestObject> ptr = MakeMyIntrusive<TestObject>();
+  MyIntrusivePtr<TestObject> moved(std::move(ptr));
+  EXPECT_FALSE(ptr);
+  EXPECT_EQ(moved->use_count(), 1);
+  ptr = std::move(moved);
+  EXPECT_EQ(ptr->use_count(), 1);
+
+  TestObject* raw = ptr.detach();
+  EXPECT_FALSE(ptr);
+  EXPECT_EQ(raw->use_count(), 1);
+  MyIntrusivePtr<TestObject> readopted(raw);
+  EXPECT_EQ(raw->use_count(), 2);
+  MyIntrusiveRelease(raw);
+  EXPECT_EQ(TestObject::instances, 1);
+}
+
+TEST(MyIntrusivePtrTest, CopyingTheObjectDoesNotCopyTheCount) {
+  MyIntrusivePtr<TestObject> ptr = MakeMyIntrusive<TestObject>();
+  MyIntrusivePtr<TestObject> copy = MakeMyIntrusive<TestObject>(*ptr);
+  EXPECT_EQ(copy->use_count(), 1);
+  *copy = *ptr;
+  EXPECT_EQ(copy->use_count(), 1);
+}
+
+TEST(MyIntrusivePtrTest, DerivedToBase) {
+  {
+    MyIntrusivePtr<DerivedObject> derived = MakeMyIntrusive<DerivedObject>();
+    MyIntrusivePtr<TestObject> base(derived);
+    EXPECT_EQ(derived->use_count(), 2);
+    MyIntrusivePtr<TestObject> moved(std::move(derived));
+    EXPECT_EQ(moved->use_count(), 2);
+  }
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MyIntrusivePtrTest, SingleThreadedCount) {
+  {
+    MyIntrusivePtr<LocalObject> ptr = MakeMyIntrusive<LocalObject>();
+    MyIntrusivePtr<LocalObject> copy(ptr);
+    EXPECT_EQ(ptr->use_count(), 2);
+  }
+  EXPECT_EQ(LocalObject::instances, 0);
+}
+
+TEST(MyIntrusivePtrTest, ThreadSafety) {
+  MyIntrusivePtr<TestObject> ptr = MakeMyIntrusive<TestObject>();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([ptr]() {
+      for (int j = 0; j < 10000; ++j) {
+        MyIntrusivePtr<TestObject> copy(ptr);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(ptr->use_count(), 1);
+}
@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "my_multi_matcher.h"
+
+namespace {
+
+// 1 GB of log lines, built once; benchmarks scan a prefix of state.range(1) bytes.
+const std::string& LogText() {
+  static const std::string text = []() {
+    constexpr size_t kBytes = size_t{1} << 30;
+    static const char* const kLevels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+    std::string log;
+    log.reserve(kBytes + 256);
+    char line[256];
+    std::mt19937 rng(1);
+    while (log.size() < kBytes) {
+      uint32_t r = static_cast<uint32_t>(rng());
+      int length = std::snprintf(line, sizeof(line),
+                                 "2026-10-17T12:%02u:%02u.%03uZ %s [worker-%02u] GET /api/v1/users/%u/orders "
+                                 "status=%u latency_ms=%u\n",
+                                 r % 60, (r >> 6) % 60, (r >> 12) % 1000, kLevels[(r >> 22) % 4], (r >> 24) % 32,
+                                 static_cast<uint32_t>(rng() % 100000), r % 7 == 0 ? 500u : 200u,
+                                 static_cast<uint32_t>(rng() % 2000));
+      log.append(line, static_cast<size_t>(length));
+    }
+    return log;
+  }();
+  return text;
+}
+
+// state.range(0) banned tokens: a few that occur in the log, the rest random words that do not.
+std::vector<MyString> MakePatterns(int64_t count) {
+  std::vector<MyString> patterns{"users/4242/", "latency_ms=1999", "[worker-07] GET", "status=500", "12:00:00"};
+  std::mt19937 rng(2);
+  char token[32];
+  while (patterns.size() < static_cast<size_t>(count)) {
+    size_t length = 6 + rng() % 9;
+    for (size_t i = 0; i < length; ++i) {
+      token[i] = "abcdefghijklmnopqrstuvwxyz0123456789_"[rng() % 37];
+    }
+    patterns.emplace_back(token, length);
+  }
+  patterns.resize(static_cast<size_t>(count));
+  return patterns;
+}
+
+MyStringView LogPrefix(int64_t bytes) {
+  const std::string& log = LogText();
+  return MyStringView(log.data(), std::min(log.size(), static_cast<size_t>(bytes)));
+}
+
+void ReportMatches(benchmark::State& state, size_t matches, MyStringView text) {
+  state.counters["matches"] = static_cast<double>(matches);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.length()));
+}
+
+// One pass of the automaton over the text, whatever the number of patterns.
+void BM_MultiMatcher(benchmark::State& state) {
+  MyMultiMatcher matcher(MakePatterns(state.range(0)));
+  MyStringView text = LogPrefix(state.range(1));
+  state.counters["states"] = static_cast<double>(matcher.state_count());
+  state.counters["classes"] = static_cast<double>(matcher.class_count());
+  size_t matches = 0;
+  for (auto _ : state) {
+    matches = 0;
+    matcher.scan(text, [&matches](const MyMatch&) { ++matches; });
+  }
+  ReportMatches(state, matches, text);
+}
+
+// What log scrubbing did before: every line searched once per pattern.
+void BM_FindLoop(benchmark::State& state) {
+  std::vector<MyString> patterns = MakePatterns(state.range(0));
+  MyStringView text = LogPrefix(state.range(1));
+  size_t matches = 0;
+  for (auto _ : state) {
+    matches = 0;
+    for (size_t start = 0, end; start < text.length(); start = end + 1) {
+      end = text.find("\n", start);
+      if (end == MyStringView::npos) end = text.length();
+      MyStringView line = text.substr(start, end - start);
+      for (const MyString& pattern : patterns) {
+        for (size_t pos = line.find(pattern); pos != MyStringView::npos; pos = line.find(pattern, pos + 1)) {
+          ++matches;
+        }
+      }
+    }
+  }
+  ReportMatches(state, matches, text);
+}
+
+constexpr int64_t kCorpusBytes = int64_t{1} << 30;
+// Searching 10k patterns one by one is too slow for the whole corpus; its rate is per byte anyway.
+constexpr int64_t kFindLoopBytes = int64_t{1} << 20;
+
+BENCHMARK(BM_MultiMatcher)->Args({100, kCorpusBytes})->Args({10'000, kCorpusBytes})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FindLoop)->Args({100, kFindLoopBytes})->Args({10'000, kFindLoopBytes})->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "my_string.h"
+#include "my_string_view.h"
+
+/**
+ * @brief One occurrence of a pattern in a scanned text.
+ */
+struct MyMatch {
+  size_t pattern;   ///< Index of the pattern in the list the matcher was built from.
+  size_t position;  ///< Offset in the text of the first character of the occurrence.
+};
+
+/**
+ * @brief Finds every occurrence of a fixed set of patterns in a single pass over a text.
+ *
+ * The patterns are compiled once into an Aho-Corasick automaton, stored as a dense transition
+ * table: one row of next states per state and one column per byte class, with the failure
+ * links already folded in. Scanning a byte is then one table load, whatever the number of
+ * patterns, so a text is scanned in O(length + matches) instead of one search per pattern.
+ *
+ * Bytes that occur in no pattern share a single class, which keeps rows short. Table entries
+ * hold the start of the next state's row rather than its number, so the scan needs no
+ * multiplication, and the top bit of an entry tells whether that state ends a pattern, so the
+ * scan only leaves its inner loop on a match.
+ *
+ * Matches may overlap. They are reported in order of their end position and, for the same end,
+ * longest first. Empty patterns never match; duplicate patterns are each reported.
+ */
+class MyMultiMatcher {
+public:
+  /**
+   * @brief Compiles patterns into an automaton.
+   *
+   * @param patterns The patterns; a match reports its index in this list.
+   * @throws std::length_error if the table would exceed 2^31 entries.
+   */
+  explicit MyMultiMatcher(const std::vector<MyString>& patterns);
+
+  /**
+   * @brief Calls on_match with a MyMatch for every occurrence of a pattern in text.
+   *
+   * @param text The text to scan.
+   * @param on_match Called as `on_match(const MyMatch&)`.
+   */
+  template<typename Callback>
+  void scan(MyStringView text, Callback&& on_match) const {
+    const uint32_t* table = table_.data();
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    uint32_t row = 0;
+    size_t pos = 0;
+    // Each step waits for the previous table load, so large texts are scanned as two streams in
+    // lockstep, one per half of a block, to keep two loads in flight. The second stream starts
+    // max_length_ bytes early, which is enough context to reach the exact state the first would
+    // have reached. Its matches are held back until the block ends, to keep them in order.
+    if (text.length() >= kInterleaveBlock && max_length_ <= kInterleaveBlock / 8) {
+      std::vector<MyMatch> held;
+      auto hold = [&held](const MyMatch& match) { held.push_back(match); };
+      const size_t half = (kInterleaveBlock + max_length_) / 2;
+      for (; pos + kInterleaveBlock <= text.length(); pos += kInterleaveBlock) {
+        const size_t second = pos + kInterleaveBlock - half;
+        uint32_t other = 0;
+        for (size_t i = 0; i < half; ++i) {
+          row = table[(row & kRowMask) + class_of_[data[pos + i]]];
+          other = table[(other & kRowMask) + class_of_[data[second + i]]];
+          if ((row | other) & kOutputFlag) {
+            if (row & kOutputFlag) {
+              report(row & kRowMask, pos + i + 1, on_match);
+            }
+            if ((other & kOutputFlag) && second + i >= pos + half) {
+              report(other & kRowMask, second + i + 1, hold);
+            }
+          }
+        }
+        for (const MyMatch& match : held) {
+          on_match(match);
+        }
+        held.clear();
+        row = other;
+      }
+    }
+    for (; pos < text.length(); ++pos) {
+      row = table[(row & kRowMask) + class_of_[data[pos]]];
+      if (row & kOutputFlag) {
+        report(row & kRowMask, pos + 1, on_match);
+      }
+    }
+  }
+
+  /**
+   * @brief Collects every occurrence of a pattern in text.
+   *
+   * @param text The text to scan.
+   * @return The matches, in the order scan() reports them.
+   */
+  std::vector<MyMatch> find_all(MyStringView text) const;
+
+  /**
+   * @brief Checks if any pattern occurs in text, stopping at the first match.
+   */
+  bool contains_any(MyStringView text) const;
+
+  /**
+   * @brief Returns the number of patterns the matcher was built from.
+   */
+  size_t pattern_count() const noexcept {
+    return pattern_lengths_.size();
+  }
+
+  /**
+   * @brief Returns the number of states of the automaton, one per distinct pattern prefix.
+   */
+  size_t state_count() const noexcept {
+    return dictionary_link_.size();
+  }
+
+  /**
+   * @brief Returns the number of byte classes, the width of a table row.
+   */
+  size_t class_count() const noexcept {
+    return class_count_;
+  }
+
+private:
+  static constexpr uint32_t kOutputFlag = uint32_t{1} << 31;  ///< Set in entries of states that end a pattern.
+  static constexpr uint32_t kRowMask = kOutputFlag - 1;
+  static constexpr uint32_t kNone = UINT32_MAX;
+  static constexpr size_t kInterleaveBlock = 64 * 1024;  ///< Texts at least this long are scanned as two streams.
+
+  template<typename Callback>
+  void report(uint32_t row, size_t end, Callback& on_match) const {
+    for (uint32_t state = row / class_count_; state != kNone; state = dictionary_link_[state]) {
+      for (uint32_t pattern = first_pattern_[state]; pattern != kNone; pattern = next_pattern_[pattern]) {
+        on_match(MyMatch{pattern, end - pattern_lengths_[pattern]});
+      }
+    }
+  }
+
+  uint32_t class_count_ = 1;
+  size_t max_length_ = 0;              ///< Length of the longest pattern.
+  uint16_t class_of_[256] = {};        ///< Byte class of each byte; 0 for bytes in no pattern.
+  std::vector<uint32_t> table_;        ///< Next row start per (state row + class), with kOutputFlag.
+  std::vector<uint32_t> first_pattern_;     ///< Per state: a pattern ending exactly there, or kNone.
+  std::vector<uint32_t> dictionary_link_;   ///< Per state: nearest proper suffix state ending a pattern, or kNone.
+  std::vector<uint32_t> next_pattern_;      ///< Per pattern: the next identical pattern, or kNone.
+  std::vector<size_t> pattern_lengths_;
+};
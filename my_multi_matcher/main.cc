@@ -0,0 +1,18 @@
+#include <iostream>
+#include "my_multi_matcher.h"
+
+int main() {
+  std::vector<MyString> banned{"he", "she", "his", "hers", "password"};
+  MyMultiMatcher matcher(banned);
+  std::cout << "states: " << matcher.state_count() << ", byte classes: " << matcher.class_count() << std::endl;
+  std::cout << "--------------------------------" << std::endl;
+
+  // One pass reports every pattern, overlapping ones included.
+  MyString line("ushers share his password");
+  matcher.scan(line, [&](const MyMatch& match) {
+    std::cout << banned[match.pattern] << " at " << match.position << std::endl;
+  });
+  std::cout << "--------------------------------" << std::endl;
+
+  std::cout << "clean line: " << (matcher.contains_any("nothing to see") ? "no" : "yes") << std::endl;
+}
@@ -0,0 +1,101 @@
+#include "my_multi_matcher.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+MyMultiMatcher::MyMultiMatcher(const std::vector<MyString>& patterns) {
+  // Give each byte that occurs in a pattern its own class, and all other bytes class 0.
+  bool used[256] = {};
+  for (const MyString& pattern : patterns) {
+    for (size_t i = 0; i < pattern.length(); ++i) {
+      used[static_cast<unsigned char>(pattern[i])] = true;
+    }
+  }
+  for (size_t byte = 0; byte < 256; ++byte) {
+    if (used[byte]) {
+      class_of_[byte] = static_cast<uint16_t>(class_count_++);
+    }
+  }
+
+  // Build the trie in the table itself, with state numbers for now; kNone marks missing edges.
+  auto add_state = [this]() {
+    if (table_.size() + class_count_ > kRowMask) {
+      throw std::length_error("MyMultiMatcher: too many states");
+    }
+    table_.resize(table_.size() + class_count_, kNone);
+    first_pattern_.push_back(kNone);
+    return static_cast<uint32_t>(first_pattern_.size() - 1);
+  };
+  add_state();
+  pattern_lengths_.resize(patterns.size());
+  next_pattern_.assign(patterns.size(), kNone);
+  // Going backwards and pushing to the front leaves identical patterns in index order.
+  for (size_t i = patterns.size(); i-- > 0;) {
+    const MyString& pattern = patterns[i];
+    pattern_lengths_[i] = pattern.length();
+    max_length_ = std::max(max_length_, pattern.length());
+    if (pattern.empty()) continue;
+    uint32_t state = 0;
+    for (size_t j = 0; j < pattern.length(); ++j) {
+      size_t edge = state * class_count_ + class_of_[static_cast<unsigned char>(pattern[j])];
+      if (table_[edge] == kNone) {
+        uint32_t child = add_state();
+        table_[edge] = child;
+      }
+      state = table_[edge];
+    }
+    next_pattern_[i] = first_pattern_[state];
+    first_pattern_[state] = static_cast<uint32_t>(i);
+  }
+
+  // Visit states by depth, so that a state's failure state, which is shallower, is complete.
+  // A missing edge then takes the failure state's edge, which turns the trie into a DFA.
+  std::vector<uint32_t> failure(first_pattern_.size(), 0);
+  dictionary_link_.assign(first_pattern_.size(), kNone);
+  std::vector<uint32_t> queue;
+  queue.reserve(first_pattern_.size());
+  for (size_t c = 0; c < class_count_; ++c) {
+    if (table_[c] == kNone) {
+      table_[c] = 0;
+    } else {
+      queue.push_back(table_[c]);
+    }
+  }
+  for (size_t head = 0; head < queue.size(); ++head) {
+    uint32_t state = queue[head];
+    for (size_t c = 0; c < class_count_; ++c) {
+      uint32_t& next = table_[state * class_count_ + c];
+      uint32_t fallback = table_[failure[state] * class_count_ + c];
+      if (next == kNone) {
+        next = fallback;
+      } else {
+        failure[next] = fallback;
+        dictionary_link_[next] = first_pattern_[fallback] != kNone ? fallback : dictionary_link_[fallback];
+        queue.push_back(next);
+      }
+    }
+  }
+
+  // Switch entries from state numbers to row starts, flagging states that end a pattern.
+  for (uint32_t& entry : table_) {
+    bool output = first_pattern_[entry] != kNone || dictionary_link_[entry] != kNone;
+    entry = entry * class_count_ | (output ? kOutputFlag : 0);
+  }
+}
+
+std::vector<MyMatch> MyMultiMatcher::find_all(MyStringView text) const {
+  std::vector<MyMatch> matches;
+  scan(text, [&matches](const MyMatch& match) { matches.push_back(match); });
+  return matches;
+}
+
+bool MyMultiMatcher::contains_any(MyStringView text) const {
+  const uint32_t* table = table_.data();
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+  uint32_t row = 0;
+  for (size_t i = 0; i < text.length(); ++i) {
+    row = table[(row & kRowMask) + class_of_[data[i]]];
+    if (row & kOutputFlag) return true;
+  }
+  return false;
+}
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "my_multi_matcher.h"
+
+namespace {
+
+// Every occurrence of every pattern, found one pattern at a time, in scan() order.
+std::vector<std::pair<size_t, size_t>> NaiveMatches(const std::vector<MyString>& patterns, const std::string& text) {
+  std::vector<std::pair<size_t, size_t>> matches;  // (end, pattern)
+  for (size_t p = 0; p < patterns.size(); ++p) {
+    std::string pattern(patterns[p].c_str(), patterns[p].length());
+    if (pattern.empty()) continue;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+      matches.emplace_back(pos + pattern.size(), p);
+    }
+  }
+  // By end, then longest first, then by index for identical patterns.
+  std::sort(matches.begin(), matches.end(), [&](const auto& a, const auto& b) {
+    if (a.first != b.first) return a.first < b.first;
+    if (patterns[a.second].length() != patterns[b.second].length()) {
+      return patterns[a.second].length() > patterns[b.second].length();
+    }
+    return a.second < b.second;
+  });
+  return matches;
+}
+
+}  // namespace
+
+TEST(MyMultiMatcherTest, OverlappingPatterns) {
+  std::vector<MyString> patterns{"he", "she", "his", "hers"};
+  MyMultiMatcher matcher(patterns);
+  EXPECT_EQ(matcher.pattern_count(), 4u);
+  EXPECT_EQ(matcher.class_count(), 6u);  // h, e, s, i, r and everything else
+
+  std::vector<MyMatch> matches = matcher.find_all("ushers");
+  ASSERT_EQ(matches.size(), 3u);
+  EXPECT_EQ(matches[0].pattern, 1u);  // "she" and "he" both end at 4, longest first
+  EXPECT_EQ(matches[0].position, 1u);
+  EXPECT_EQ(matches[1].pattern, 0u);
+  EXPECT_EQ(matches[1].position, 2u);
+  EXPECT_EQ(matches[2].pattern, 3u);
+  EXPECT_EQ(matches[2].position, 2u);
+
+  EXPECT_TRUE(matcher.contains_any("this"));
+  EXPECT_FALSE(matcher.contains_any("nothing to see"));
+  EXPECT_TRUE(matcher.find_all("").empty());
+}
+
+TEST(MyMultiMatcherTest, EmptyDuplicateAndBinaryPatterns) {
+  std::vector<MyString> patterns{"", "ab", MyString("\0\xff", 2), "ab"};
+  MyMultiMatcher matcher(patterns);
+  std::vector<MyMatch> matches = matcher.find_all(MyStringView("xab\0\xff", 5));
+  ASSERT_EQ(matches.size(), 3u);
+  EXPECT_EQ(matches[0].pattern, 1u);
+  EXPECT_EQ(matches[1].pattern, 3u);
+  EXPECT_EQ(matches[2].pattern, 2u);
+  EXPECT_EQ(matches[2].position, 3u);
+
+  MyMultiMatcher none(std::vector<MyString>{});
+  EXPECT_EQ(none.state_count(), 1u);
+  EXPECT_FALSE(none.contains_any("anything"));
+}
+
+// Rounds from 50 on scan texts long enough to be split into two streams per block.
+TEST(MyMultiMatcherTest, MatchesNaiveSearch) {
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> letter(0, 2);
+  for (int round = 0; round < 54; ++round) {
+    std::vector<MyString> patterns;
+    for (int p = 0; p < 1 + round % 50; ++p) {
+      std::string pattern(static_cast<size_t>(1 + rng() % (round < 50 ? 6 : 12)), ' ');
+      for (char& c : pattern) {
+        c = static_cast<char>('a' + letter(rng));
+      }
+      patterns.emplace_back(pattern.c_str());
+    }
+    std::string text(round < 50 ? 500 : 200'000 + rng() % 1000, ' ');
+    for (char& c : text) {
+      c = static_cast<char>('a' + letter(rng));
+    }
+
+    MyMultiMatcher matcher(patterns);
+    std::vector<std::pair<size_t, size_t>> expected = NaiveMatches(patterns, text);
+    std::vector<std::pair<size_t, size_t>> actual;
+    matcher.scan(MyStringView(text.data(), text.size()), [&](const MyMatch& match) {
+      actual.emplace_back(match.position + patterns[match.pattern].length(), match.pattern);
+    });
+    EXPECT_EQ(actual, expected);
+  }
+}
@@ -0,0 +1,50 @@
+#include <cstdint>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "my_object_pool.h"
+#include "my_unique_ptr.h"
+
+namespace {
+
+// Roughly the per-request state our handlers allocate.
+struct Request {
+  explicit Request(int64_t id) : id(id) {}
+  int64_t id;
+  int64_t deadline{0};
+  char headers[48]{};
+};
+
+// Keeps kLive objects per thread alive and replaces them in turn, so every iteration frees one
+// object and allocates another, like a handler finishing a request and starting the next.
+constexpr size_t kLive = 256;
+
+template<typename Make>
+void RunChurn(benchmark::State& state, Make make) {
+  using Ptr = decltype(make(0));
+  std::vector<Ptr> live;
+  for (size_t i = 0; i < kLive; ++i) {
+    live.push_back(make(static_cast<int64_t>(i)));
+  }
+  size_t next = 0;
+  int64_t id = 0;
+  for (auto _ : state) {
+    live[next] = make(++id);
+    benchmark::DoNotOptimize(live[next].get());
+    next = (next + 1) % kLive;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_MakeMyUniqueChurn(benchmark::State& state) {
+  RunChurn(state, [](int64_t id) { return MakeMyUnique<Request>(id); });
+}
+
+void BM_MyObjectPoolChurn(benchmark::State& state) {
+  static MyObjectPool<Request> pool;
+  RunChurn(state, [](int64_t id) { return pool.acquire(id); });
+}
+
+BENCHMARK(BM_MakeMyUniqueChurn)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_MyObjectPoolChurn)->ThreadRange(1, 32)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+#include "my_unique_ptr.h"
+
+/**
+ * @brief The part of MyObjectPool that does not depend on the object type: finding the calling
+ * thread's cache of a pool, and handing caches back when their thread exits.
+ *
+ * Each pool gets an id that is never reused, so a thread can remember the cache it last used
+ * without a stale entry ever matching a later pool at the same address.
+ */
+class MyObjectPoolBase {
+public:
+  MyObjectPoolBase(const MyObjectPoolBase&) = delete;
+  MyObjectPoolBase& operator=(const MyObjectPoolBase&) = delete;
+
+protected:
+  MyObjectPoolBase();
+
+  ~MyObjectPoolBase();
+
+  /**
+   * @brief Retrieves the calling thread's cache for this pool.
+   *
+   * @return The cache registered with set_thread_cache(), or nullptr if there is none yet.
+   */
+  void* thread_cache() const noexcept {
+    if (last_.pool_id == id_) {
+      return last_.cache;
+    }
+    return find_thread_cache();
+  }
+
+  /**
+   * @brief Registers cache as the calling thread's cache for this pool. When the thread exits,
+   * abandon_cache(cache) is called if the pool still exists.
+   */
+  void set_thread_cache(void* cache);
+
+  /**
+   * @brief Hands back the cache of an exiting thread. Called with no lock of the pool held.
+   */
+  virtual void abandon_cache(void* cache) noexcept = 0;
+
+  /**
+   * @brief Stops abandon_cache() calls for this pool. The derived destructor must call it before
+   * tearing down the state abandon_cache() uses; the base destructor calls it again harmlessly.
+   */
+  void unregister() noexcept;
+
+private:
+  friend class MyObjectPoolThreadCaches;
+
+  struct LastCache {
+    uint64_t pool_id;
+    void* cache;
+  };
+
+  void* find_thread_cache() const noexcept;
+
+  const uint64_t id_;  ///< Unique among all pools ever created; 0 is never used.
+
+  static inline thread_local LastCache last_{0, nullptr};  ///< The cache the thread used last.
+};
+
+/**
+ * @brief A pool of objects of type T with per-thread free lists over slab-backed storage.
+ *
+ * acquire() constructs an object in a free slot and returns a MyUniquePtr whose deleter destroys
+ * the object and puts its slot on the free list of the thread that releases it. Each thread
+ * allocates from and frees to its own list, so the common case takes no lock and makes no call to
+ * the general-purpose allocator. Slots are carved from slabs of kSlabSize objects, which the pool
+ * frees only when it is destroyed.
+ *
+ * A thread whose list grows past two batches, as when one thread produces objects that others
+ * release, moves a batch of kBatchSize slots to a shared depot; a thread whose list is empty takes a
+ * batch from the depot before it carves a new slab. Both are O(1) under the pool's mutex, once per
+ * kBatchSize operations. The list of an exiting thread is kept for the next thread that uses the
+ * pool.
+ *
+ * The pool must outlive every object it hands out.
+ *
+ * @tparam T The type of the pooled objects.
+ */
+template<typename T>
+class MyObjectPool : private MyObjectPoolBase {
+  union Slot;
+
+public:
+  /**
+   * @brief The number of slots a thread moves to or from the depot at a time.
+   */
+  static constexpr size_t kBatchSize = 64;
+
+  /**
+   * @brief The number of slots in one slab.
+   */
+  static constexpr size_t kSlabSize = 4 * kBatchSize;
+
+  /**
+   * @brief The deleter of pooled objects: destroys the object and returns its slot to the pool.
+   */
+  class PoolDeleter {
+  public:
+    PoolDeleter() noexcept = default;
+
+    explicit PoolDeleter(MyObjectPool* pool) noexcept : pool_(pool) {}
+
+    void operator()(T* object) const noexcept {
+      pool_->release(object);
+    }
+
+    /**
+     * @brief Retrieves the pool the object belongs to.
+     */
+    MyObjectPool* pool() const noexcept {
+      return pool_;
+    }
+
+  private:
+    MyObjectPool* pool_ = nullptr;
+  };
+
+  /**
+   * @brief The pointer type acquire() returns.
+   */
+  using Ptr = MyUniquePtr<T, PoolDeleter>;
+
+  MyObjectPool() = default;
+
+  /**
+   * @brief Frees all slabs. Every object handed out must have been released.
+   */
+  ~MyObjectPool() {
+    unregister();
+  }
+
+  /**
+   * @brief Constructs an object in a slot of the pool.
+   *
+   * If the constructor throws, the slot goes back to the free list and the exception propagates.
+   *
+   * @param args Arguments forwarded to the constructor of T.
+   * @return A MyUniquePtr that returns the object to this pool.
+   */
+  template<typename... Args>
+  Ptr acquire(Args&&... args) {
+    Cache& cache = local_cache();
+    if (cache.free == nullptr) {
+      refill(cache);
+    }
+    Slot* slot = cache.free;
+    cache.free = slot->next;
+    --cache.count;
+    T* object;
+    try {
+      object = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+    } catch (...) {
+      slot->next = cache.free;
+      cache.free = slot;
+      ++cache.count;
+      throw;
+    }
+    return Ptr(object, PoolDeleter(this));
+  }
+
+  /**
+   * @brief Retrieves the number of slots carved so far, in use or free.
+   */
+  size_t capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slabs_.size() * kSlabSize;
+  }
+
+private:
+  union Slot {
+    Slot* next;                                ///< The next free slot, while the slot is free.
+    alignas(T) unsigned char storage[sizeof(T)];  ///< The object, while the slot is in use.
+  };
+
+  /**
+   * @brief A free list used by one thread at a time.
+   */
+  struct Cache {
+    Slot* free = nullptr;
+    size_t count = 0;
+    bool claimed = true;  ///< A live thread uses this cache; guarded by mutex_.
+  };
+
+  void release(T* object) noexcept {
+    object->~T();
+    Slot* slot = reinterpret_cast<Slot*>(object);
+    Cache& cache = local_cache();
+    slot->next = cache.free;
+    cache.free = slot;
+    if (++cache.count > 2 * kBatchSize) {
+      spill(cache);
+    }
+  }
+
+  Cache& local_cache() {
+    if (void* cache = thread_cache()) {
+      return *static_cast<Cache*>(cache);
+    }
+    Cache* cache = claim_cache();
+    set_thread_cache(cache);
+    return *cache;
+  }
+
+  // Reuses the cache of an exited thread if there is one, so its free slots are not stranded.
+  Cache* claim_cache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const std::unique_ptr<Cache>& cache : caches_) {
+      if (!cache->claimed) {
+        cache->claimed = true;
+        return cache.get();
+      }
+    }
+    caches_.push_back(std::make_unique<Cache>());
+    return caches_.back().get();
+  }
+
+  void abandon_cache(void* cache) noexcept override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    static_cast<Cache*>(cache)->claimed = false;
+  }
+
+  // Moves kBatchSize slots to the depot. The most recently freed slots, at the front of the list,
+  // are the likeliest to be in cache, so the batch is cut from behind them.
+  void spill(Cache& cache) noexcept {
+    Slot* keep = nth_slot(cache.free, kBatchSize - 1);
+    Slot* batch = keep->next;
+    Slot* last = nth_slot(batch, kBatchSize - 1);
+    keep->next = last->next;
+    last->next = nullptr;
+    cache.count -= kBatchSize;
+    std::lock_guard<std::mutex> lock(mutex_);
+    depot_.push_back(batch);  // Never allocates: refill() reserved room for every batch.
+  }
+
+  static Slot* nth_slot(Slot* slot, size_t n) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+      slot = slot->next;
+    }
+    return slot;
+  }
+
+  // Fills an empty cache with a batch from the depot, or else carves a new slab into batches, keeps
+  // one and puts the others in the depot.
+  void refill(Cache& cache) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!depot_.empty()) {
+        cache.free = depot_.back();
+        cache.count = kBatchSize;
+        depot_.pop_back();
+        return;
+      }
+    }
+    std::unique_ptr<Slot[]> slab(new Slot[kSlabSize]);
+    for (size_t i = 0; i < kSlabSize; ++i) {
+      slab[i].next = (i + 1) % kBatchSize == 0 ? nullptr : &slab[i + 1];
+    }
+    Slot* first = slab.get();
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Reserving room for every batch the pool could have means spill() only allocates when slabs
+    // are added, never in the steady state.
+    depot_.reserve((slabs_.size() + 1) * kSlabSize / kBatchSize);
+    slabs_.push_back(std::move(slab));
+    for (size_t i = kBatchSize; i < kSlabSize; i += kBatchSize) {
+      depot_.push_back(first + i);
+    }
+    cache.free = first;
+    cache.count = kBatchSize;
+  }
+
+  mutable std::mutex mutex_;                   ///< Guards the members below, but not the caches' lists.
+  std::vector<std::unique_ptr<Slot[]>> slabs_;  ///< All storage of the pool.
+  std::vector<Slot*> depot_;                    ///< Batches of kBatchSize free slots, each a linked list.
+  std::vector<std::unique_ptr<Cache>> caches_;  ///< One per thread that used the pool.
+};
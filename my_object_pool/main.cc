@@ -0,0 +1,35 @@
+#include <iostream>
+#include "my_object_pool.h"
+
+/**
+ * @brief A test class for MyObjectPool.
+ *
+ * It prints messages upon construction and destruction to help observe that pooled objects are
+ * constructed and destroyed like any other, while their memory is reused.
+ */
+class Object {
+ public:
+  explicit Object(int id) : id_(id) {
+    std::cout << "Object " << id_ << " constructor" << std::endl;
+  }
+
+  ~Object() {
+    std::cout << "Object " << id_ << " destructor" << std::endl;
+  }
+
+ private:
+  int id_;
+};
+
+int main() {
+  MyObjectPool<Object> pool;
+  MyObjectPool<Object>::Ptr ptr1 = pool.acquire(1);
+  const Object* address = ptr1.get();
+  std::cout << "pool capacity: " << pool.capacity() << std::endl;
+  std::cout << "--------------------------------" << std::endl;
+
+  ptr1.reset();
+  MyObjectPool<Object>::Ptr ptr2 = pool.acquire(2);
+  std::cout << "ptr2 " << (ptr2.get() == address ? "reuses" : "does not reuse") << " the slot of ptr1" << std::endl;
+  std::cout << "pool capacity: " << pool.capacity() << std::endl;
+}
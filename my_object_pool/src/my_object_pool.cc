@@ -0,0 +1,107 @@
+#include "my_object_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_set>
+
+namespace {
+
+// Ids of the pools that exist. Leaked, so that threads exiting during static destruction can still
+// consult it.
+struct LivePools {
+  std::mutex mutex;
+  std::unordered_set<uint64_t> ids;
+};
+
+LivePools& live_pools() {
+  static LivePools* pools = new LivePools();
+  return *pools;
+}
+
+std::atomic<uint64_t> next_pool_id{1};
+
+// Set once the thread's MyObjectPoolThreadCaches is gone, so that pools used by later thread-exit
+// destructors do not bring it back.
+thread_local bool thread_caches_destroyed = false;
+
+}  // namespace
+
+// The caches a thread has registered, handed back to their pools when the thread exits.
+class MyObjectPoolThreadCaches {
+public:
+  struct Entry {
+    uint64_t pool_id;
+    MyObjectPoolBase* pool;
+    void* cache;
+  };
+
+  static MyObjectPoolThreadCaches& current() {
+    thread_local MyObjectPoolThreadCaches caches;
+    return caches;
+  }
+
+  ~MyObjectPoolThreadCaches() {
+    thread_caches_destroyed = true;
+    MyObjectPoolBase::last_ = {0, nullptr};
+    // Holding the lock keeps every pool in ids alive until abandon_cache() returns.
+    LivePools& pools = live_pools();
+    std::lock_guard<std::mutex> lock(pools.mutex);
+    for (const Entry& entry : entries) {
+      if (pools.ids.count(entry.pool_id) != 0) {
+        entry.pool->abandon_cache(entry.cache);
+      }
+    }
+  }
+
+  std::vector<Entry> entries;
+};
+
+MyObjectPoolBase::MyObjectPoolBase() : id_(next_pool_id.fetch_add(1, std::memory_order_relaxed)) {
+  LivePools& pools = live_pools();
+  std::lock_guard<std::mutex> lock(pools.mutex);
+  pools.ids.insert(id_);
+}
+
+MyObjectPoolBase::~MyObjectPoolBase() {
+  unregister();
+}
+
+void MyObjectPoolBase::unregister() noexcept {
+  LivePools& pools = live_pools();
+  std::lock_guard<std::mutex> lock(pools.mutex);
+  pools.ids.erase(id_);
+}
+
+void MyObjectPoolBase::set_thread_cache(void* cache) {
+  if (thread_caches_destroyed) {
+    // Too late to hand the cache back at exit; it stays claimed.
+    last_ = {id_, cache};
+    return;
+  }
+  MyObjectPoolThreadCaches& caches = MyObjectPoolThreadCaches::current();
+  // Entries of destroyed pools can never match again; drop them while we are here.
+  {
+    LivePools& pools = live_pools();
+    std::lock_guard<std::mutex> lock(pools.mutex);
+    caches.entries.erase(std::remove_if(caches.entries.begin(), caches.entries.end(),
+                                        [&](const MyObjectPoolThreadCaches::Entry& entry) {
+                                          return pools.ids.count(entry.pool_id) == 0;
+                                        }),
+                         caches.entries.end());
+  }
+  caches.entries.push_back({id_, this, cache});
+  last_ = {id_, cache};
+}
+
+void* MyObjectPoolBase::find_thread_cache() const noexcept {
+  if (thread_caches_destroyed) {
+    return nullptr;
+  }
+  for (const MyObjectPoolThreadCaches::Entry& entry : MyObjectPoolThreadCaches::current().entries) {
+    if (entry.pool_id == id_) {
+      last_ = {entry.pool_id, entry.cache};
+      return entry.cache;
+    }
+  }
+  return nullptr;
+}
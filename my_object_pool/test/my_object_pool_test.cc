@@ -0,0 +1,124 @@
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "my_object_pool.h"
+
+namespace {
+
+class TestObject {
+ public:
+  static std::atomic<int> instance_count;
+  explicit TestObject(std::string name = "") : name(std::move(name)) { ++instance_count; }
+  ~TestObject() { --instance_count; }
+  std::string name;
+};
+
+std::atomic<int> TestObject::instance_count{0};
+
+class ThrowingObject {
+ public:
+  explicit ThrowingObject(bool fail) {
+    if (fail) {
+      throw std::runtime_error("constructor failed");
+    }
+  }
+};
+
+}  // namespace
+
+TEST(MyObjectPoolTest, AcquireConstructsAndReleaseDestroys) {
+  MyObjectPool<TestObject> pool;
+  {
+    MyObjectPool<TestObject>::Ptr object = pool.acquire("first");
+    EXPECT_EQ(object->name, "first");
+    EXPECT_EQ(TestObject::instance_count, 1);
+    EXPECT_EQ(object.get_deleter().pool(), &pool);
+  }
+  EXPECT_EQ(TestObject::instance_count, 0);
+}
+
+TEST(MyObjectPoolTest, ReusesReleasedSlots) {
+  MyObjectPool<TestObject> pool;
+  TestObject* address = nullptr;
+  {
+    MyObjectPool<TestObject>::Ptr object = pool.acquire();
+    address = object.get();
+  }
+  MyObjectPool<TestObject>::Ptr object = pool.acquire();
+  EXPECT_EQ(object.get(), address);
+  EXPECT_EQ(pool.capacity(), MyObjectPool<TestObject>::kSlabSize);
+}
+
+TEST(MyObjectPoolTest, GrowsBySlabs) {
+  MyObjectPool<int> pool;
+  std::vector<MyObjectPool<int>::Ptr> objects;
+  std::set<int*> addresses;
+  for (size_t i = 0; i < MyObjectPool<int>::kSlabSize + 1; ++i) {
+    objects.push_back(pool.acquire(static_cast<int>(i)));
+    addresses.insert(objects.back().get());
+  }
+  EXPECT_EQ(addresses.size(), objects.size());
+  EXPECT_EQ(pool.capacity(), 2 * MyObjectPool<int>::kSlabSize);
+  for (size_t i = 0; i < objects.size(); ++i) {
+    EXPECT_EQ(*objects[i], static_cast<int>(i));
+  }
+}
+
+TEST(MyObjectPoolTest, ThrowingConstructorKeepsSlot) {
+  MyObjectPool<ThrowingObject> pool;
+  EXPECT_THROW(pool.acquire(true), std::runtime_error);
+  MyObjectPool<ThrowingObject>::Ptr object = pool.acquire(false);
+  EXPECT_TRUE(object);
+  EXPECT_EQ(pool.capacity(), MyObjectPool<ThrowingObject>::kSlabSize);
+}
+
+// One thread acquires, another releases: the releasing thread's list overflows into the depot and
+// the acquiring thread refills from it, so the pool stops growing.
+TEST(MyObjectPoolTest, CrossThreadReleaseReturnsSlotsThroughDepot) {
+  MyObjectPool<TestObject> pool;
+  constexpr size_t kRounds = 50;
+  constexpr size_t kPerRound = 1000;
+  for (size_t round = 0; round < kRounds; ++round) {
+    std::vector<MyObjectPool<TestObject>::Ptr> objects;
+    for (size_t i = 0; i < kPerRound; ++i) {
+      objects.push_back(pool.acquire());
+    }
+    std::thread consumer([&objects] { objects.clear(); });
+    consumer.join();
+  }
+  EXPECT_EQ(TestObject::instance_count, 0);
+  EXPECT_LE(pool.capacity(), 2 * kPerRound + 2 * MyObjectPool<TestObject>::kSlabSize);
+}
+
+TEST(MyObjectPoolTest, ExitedThreadCacheIsReused) {
+  MyObjectPool<int> pool;
+  std::thread first([&pool] { pool.acquire(1); });
+  first.join();
+  std::thread second([&pool] { pool.acquire(2); });
+  second.join();
+  EXPECT_EQ(pool.capacity(), MyObjectPool<int>::kSlabSize);
+}
+
+TEST(MyObjectPoolTest, ConcurrentChurn) {
+  MyObjectPool<TestObject> pool;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool] {
+      std::vector<MyObjectPool<TestObject>::Ptr> objects;
+      for (int i = 0; i < 10000; ++i) {
+        objects.push_back(pool.acquire("x"));
+        if (objects.size() == 100) {
+          objects.clear();
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(TestObject::instance_count, 0);
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief What MyReclaimer::retire() does when the queue is full.
+ */
+enum class MyBackpressure {
+  kBlock,          ///< Wait until the reclaimer thread takes the queue. Bounds memory, but may stall
+                   ///< the caller for as long as the batch being destroyed takes.
+  kDestroyInline,  ///< Destroy the object on the calling thread. Never waits, pays the full cost.
+};
+
+/**
+ * @brief A background thread that destroys objects in batches on behalf of the threads that
+ * release them.
+ *
+ * Releasing threads append the object and a type-erased destroy function to a queue under a
+ * short lock; the reclaimer thread is woken when the queue becomes non-empty, takes the whole
+ * queue and destroys it. Freeing a large structure then costs the caller a lock and a push
+ * instead of the destructor and the unmapping. The Deferred policy of MySharedPtr hands its
+ * objects to a reclaimer of its own; MyAsyncDeleter for MyUniquePtr uses instance() unless it is
+ * given another.
+ *
+ * The queue holds at most capacity() objects and never allocates after construction. When it is
+ * full, retire() applies the backpressure policy. Because the reclaimer takes the queue in one
+ * swap, at most twice the capacity is waiting or being destroyed at any time.
+ *
+ * Objects released by destructors that the reclaimer itself runs are queued for the next batch,
+ * so long chains do not recurse, or destroyed right there when the queue is full, since the
+ * reclaimer cannot wait for itself. Retired objects must be safe to destroy on another thread.
+ */
+class MyReclaimer {
+public:
+  /**
+   * @brief A snapshot of the reclaimer's metrics.
+   */
+  struct Stats {
+    size_t queue_depth = 0;       ///< Objects waiting for the next batch.
+    size_t max_queue_depth = 0;   ///< Largest queue_depth seen so far.
+    size_t reclaimed = 0;         ///< Objects destroyed by the reclaimer thread so far.
+    size_t batches = 0;           ///< Batches run so far.
+    size_t destroyed_inline = 0;  ///< Objects destroyed by callers because the queue was full.
+    size_t blocked = 0;           ///< retire() calls that waited because the queue was full.
+    std::chrono::nanoseconds last_latency{0};   ///< From the first retire() of the last batch until it was destroyed.
+    std::chrono::nanoseconds max_latency{0};    ///< Largest last_latency seen so far.
+    std::chrono::nanoseconds total_latency{0};  ///< Sum of all batch latencies; divide by batches for the mean.
+  };
+
+  /**
+   * @brief Retrieves the shared reclaimer.
+   *
+   * It is created on first use with a capacity of 1024 and kBlock, and never destroyed, so that
+   * objects released during static destruction are still handled. Objects still queued at
+   * process exit are not destroyed; call flush() first if that matters.
+   *
+   * Everything that uses it shares one queue: once it is full, a release waits behind whatever
+   * the reclaimer thread is destroying, however large. Latency-critical code that releases
+   * objects often should use a reclaimer of its own, or kDestroyInline.
+   */
+  static MyReclaimer& instance();
+
+  /**
+   * @brief Starts the reclaimer thread.
+   *
+   * @param capacity The most objects the queue holds.
+   * @param backpressure What retire() does when the queue is full.
+   */
+  explicit MyReclaimer(size_t capacity = 1024, MyBackpressure backpressure = MyBackpressure::kBlock);
+
+  MyReclaimer(const MyReclaimer&) = delete;
+  MyReclaimer& operator=(const MyReclaimer&) = delete;
+
+  /**
+   * @brief Destroys everything still queued and stops the reclaimer thread.
+   */
+  ~MyReclaimer();
+
+  /**
+   * @brief Queues an object for destruction on the reclaimer thread.
+   *
+   * @param object The object.
+   * @param destroy Destroys and frees object.
+   */
+  void retire(void* object, void (*destroy)(void*)) noexcept;
+
+  /**
+   * @brief Blocks until the queue is empty and no batch is running.
+   *
+   * Meant for shutdown and tests. If other threads keep releasing objects, it may wait
+   * indefinitely. Must not be called from a destructor that the reclaimer runs.
+   */
+  void flush();
+
+  /**
+   * @brief Changes what retire() does when the queue is full.
+   */
+  void set_backpressure(MyBackpressure backpressure);
+
+  /**
+   * @brief Retrieves the most objects the queue holds.
+   */
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  /**
+   * @brief Retrieves the current metrics.
+   */
+  Stats stats() const;
+
+private:
+  struct Item {
+    void* object;
+    void (*destroy)(void*);
+  };
+
+  void run();
+
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;   ///< Signals the reclaimer thread that work or stop_ has arrived.
+  std::condition_variable space_;  ///< Signals blocked retire() calls that the queue was taken.
+  std::condition_variable idle_;   ///< Signals flush() that the queue has drained.
+  std::vector<Item> queue_;        ///< Reserved to capacity_ up front.
+  std::chrono::steady_clock::time_point oldest_;  ///< When the first object in queue_ was retired.
+  MyBackpressure backpressure_;
+  bool busy_ = false;              ///< A batch is being destroyed.
+  bool stop_ = false;
+  size_t nested_ = 0;              ///< Objects the running batch destroyed inline; reclaimer thread only.
+  Stats stats_;
+  std::thread thread_;
+};
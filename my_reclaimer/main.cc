@@ -0,0 +1,29 @@
+#include <iostream>
+#include <vector>
+#include "my_reclaimer.h"
+
+int main() {
+  MyReclaimer reclaimer(2, MyBackpressure::kDestroyInline);
+  for (int i = 0; i < 5; ++i) {
+    reclaimer.retire(new std::vector<int>(1 << 20, i), [](void* object) {
+      delete static_cast<std::vector<int>*>(object);
+    });
+  }
+  reclaimer.flush();
+
+  MyReclaimer::Stats stats = reclaimer.stats();
+  std::cout << "reclaimed: " << stats.reclaimed << ", destroyed inline: " << stats.destroyed_inline << std::endl;
+  std::cout << "batches: " << stats.batches << ", max queue depth: " << stats.max_queue_depth << std::endl;
+  std::cout << "--------------------------------" << std::endl;
+
+  // Blocking instead bounds the queue without ever destroying on the caller.
+  reclaimer.set_backpressure(MyBackpressure::kBlock);
+  for (int i = 0; i < 5; ++i) {
+    reclaimer.retire(new std::vector<int>(1 << 20, i), [](void* object) {
+      delete static_cast<std::vector<int>*>(object);
+    });
+  }
+  reclaimer.flush();
+  stats = reclaimer.stats();
+  std::cout << "reclaimed: " << stats.reclaimed << ", destroyed inline: " << stats.destroyed_inline << std::endl;
+}
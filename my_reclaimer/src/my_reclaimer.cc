@@ -0,0 +1,109 @@
+#include "my_reclaimer.h"
+
+#include <algorithm>
+
+MyReclaimer& MyReclaimer::instance() {
+  static MyReclaimer* reclaimer = new MyReclaimer();
+  return *reclaimer;
+}
+
+MyReclaimer::MyReclaimer(size_t capacity, MyBackpressure backpressure)
+    : capacity_(std::max<size_t>(capacity, 1)), backpressure_(backpressure) {
+  queue_.reserve(capacity_);
+  thread_ = std::thread([this]() { run(); });
+}
+
+MyReclaimer::~MyReclaimer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+}
+
+void MyReclaimer::retire(void* object, void (*destroy)(void*)) noexcept {
+  bool on_reclaimer = std::this_thread::get_id() == thread_.get_id();
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (queue_.size() == capacity_) {
+    if (on_reclaimer) {
+      lock.unlock();
+      destroy(object);
+      ++nested_;
+      return;
+    }
+    if (backpressure_ == MyBackpressure::kDestroyInline) {
+      ++stats_.destroyed_inline;
+      lock.unlock();
+      destroy(object);
+      return;
+    }
+    ++stats_.blocked;
+    space_.wait(lock, [this]() { return queue_.size() < capacity_; });
+  }
+  bool was_empty = queue_.empty();
+  queue_.push_back({object, destroy});
+  if (was_empty) {
+    oldest_ = std::chrono::steady_clock::now();
+  }
+  stats_.max_queue_depth = std::max(stats_.max_queue_depth, queue_.size());
+  lock.unlock();
+  // Only the first object of a batch needs to wake the thread; the rest ride along.
+  if (was_empty) {
+    wake_.notify_one();
+  }
+}
+
+void MyReclaimer::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this]() { return queue_.empty() && !busy_; });
+}
+
+void MyReclaimer::set_backpressure(MyBackpressure backpressure) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  backpressure_ = backpressure;
+}
+
+MyReclaimer::Stats MyReclaimer::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats = stats_;
+  stats.queue_depth = queue_.size();
+  return stats;
+}
+
+void MyReclaimer::run() {
+  std::vector<Item> batch;
+  batch.reserve(capacity_);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+    // Swapping hands the queue's buffer to the batch and the batch's old, equally reserved,
+    // buffer back to the queue, so that neither allocates.
+    batch.swap(queue_);
+    std::chrono::steady_clock::time_point oldest = oldest_;
+    busy_ = true;
+    lock.unlock();
+    space_.notify_all();
+
+    for (const Item& item : batch) {
+      item.destroy(item.object);
+    }
+    std::chrono::nanoseconds latency = std::chrono::steady_clock::now() - oldest;
+
+    lock.lock();
+    busy_ = false;
+    stats_.reclaimed += batch.size() + nested_;
+    nested_ = 0;
+    ++stats_.batches;
+    stats_.last_latency = latency;
+    stats_.max_latency = std::max(stats_.max_latency, latency);
+    stats_.total_latency += latency;
+    batch.clear();
+    if (queue_.empty()) {
+      idle_.notify_all();
+    }
+  }
+}
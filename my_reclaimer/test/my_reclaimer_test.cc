@@ -0,0 +1,156 @@
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <gtest/gtest.h>
+#include "my_reclaimer.h"
+
+namespace {
+
+// Holds the reclaimer thread inside the first destroy() until opened, so the queue can be filled.
+class ReclaimerGate {
+public:
+  static void Destroy(void* gate) {
+    static_cast<ReclaimerGate*>(gate)->hold();
+  }
+
+  void wait_until_held() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this]() { return held_; });
+  }
+
+  void open() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      open_ = true;
+    }
+    changed_.notify_all();
+  }
+
+private:
+  void hold() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    held_ = true;
+    changed_.notify_all();
+    changed_.wait(lock, [this]() { return open_; });
+  }
+
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  bool held_ = false;
+  bool open_ = false;
+};
+
+void RecordDestroyingThread(void* thread) {
+  static_cast<std::atomic<std::thread::id>*>(thread)->store(std::this_thread::get_id());
+}
+
+// A link of a chain whose destruction releases the next link through the same reclaimer.
+struct Link {
+  MyReclaimer* reclaimer;
+  Link* next;
+  std::atomic<int>* destroyed;
+
+  static void Destroy(void* object) {
+    Link* link = static_cast<Link*>(object);
+    if (link->next) {
+      link->reclaimer->retire(link->next, &Link::Destroy);
+    }
+    ++*link->destroyed;
+    delete link;
+  }
+};
+
+}  // namespace
+
+TEST(MyReclaimerTest, DestroysInTheBackground) {
+  MyReclaimer reclaimer;
+  std::atomic<std::thread::id> destroyed_on;
+  reclaimer.retire(&destroyed_on, &RecordDestroyingThread);
+  reclaimer.flush();
+  EXPECT_NE(destroyed_on.load(), std::thread::id());
+  EXPECT_NE(destroyed_on.load(), std::this_thread::get_id());
+
+  MyReclaimer::Stats stats = reclaimer.stats();
+  EXPECT_EQ(stats.reclaimed, 1u);
+  EXPECT_EQ(stats.batches, 1u);
+  EXPECT_EQ(stats.queue_depth, 0u);
+  EXPECT_GE(stats.max_latency, stats.last_latency);
+}
+
+TEST(MyReclaimerTest, ReleasesFromTheReclaimerFormTheNextBatch) {
+  MyReclaimer reclaimer(4);
+  std::atomic<int> destroyed{0};
+  Link* head = nullptr;
+  for (int i = 0; i < 3; ++i) {
+    head = new Link{&reclaimer, head, &destroyed};
+  }
+  reclaimer.retire(head, &Link::Destroy);
+  reclaimer.flush();
+  EXPECT_EQ(destroyed.load(), 3);
+  EXPECT_EQ(reclaimer.stats().reclaimed, 3u);
+  EXPECT_EQ(reclaimer.stats().batches, 3u);
+
+  // With a full queue the reclaimer cannot wait for itself, so it destroys links right away,
+  // even under kBlock.
+  MyReclaimer tiny(1);
+  ReclaimerGate gate;
+  tiny.retire(&gate, &ReclaimerGate::Destroy);
+  gate.wait_until_held();
+  head = nullptr;
+  for (int i = 0; i < 3; ++i) {
+    head = new Link{&tiny, head, &destroyed};
+  }
+  tiny.retire(head, &Link::Destroy);
+  gate.open();
+  tiny.flush();
+  EXPECT_EQ(destroyed.load(), 6);
+  EXPECT_EQ(tiny.stats().reclaimed, 4u);
+  EXPECT_EQ(tiny.stats().destroyed_inline, 0u);
+  EXPECT_EQ(tiny.stats().blocked, 0u);
+}
+
+TEST(MyReclaimerTest, FullQueueDestroysInline) {
+  MyReclaimer reclaimer(1, MyBackpressure::kDestroyInline);
+  ReclaimerGate gate;
+  reclaimer.retire(&gate, &ReclaimerGate::Destroy);
+  gate.wait_until_held();
+
+  std::atomic<std::thread::id> queued;
+  std::atomic<std::thread::id> overflowed;
+  reclaimer.retire(&queued, &RecordDestroyingThread);
+  reclaimer.retire(&overflowed, &RecordDestroyingThread);
+  EXPECT_EQ(overflowed.load(), std::this_thread::get_id());
+  EXPECT_EQ(queued.load(), std::thread::id());
+  EXPECT_EQ(reclaimer.stats().queue_depth, 1u);
+  EXPECT_EQ(reclaimer.stats().destroyed_inline, 1u);
+
+  gate.open();
+  reclaimer.flush();
+  EXPECT_NE(queued.load(), std::thread::id());
+  EXPECT_NE(queued.load(), std::this_thread::get_id());
+  EXPECT_EQ(reclaimer.stats().reclaimed, 2u);
+}
+
+TEST(MyReclaimerTest, FullQueueBlocks) {
+  MyReclaimer reclaimer(1, MyBackpressure::kBlock);
+  ReclaimerGate gate;
+  reclaimer.retire(&gate, &ReclaimerGate::Destroy);
+  gate.wait_until_held();
+
+  std::atomic<std::thread::id> queued;
+  std::atomic<std::thread::id> waited;
+  reclaimer.retire(&queued, &RecordDestroyingThread);
+  std::thread releaser([&]() { reclaimer.retire(&waited, &RecordDestroyingThread); });
+  while (reclaimer.stats().blocked == 0) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(waited.load(), std::thread::id());
+
+  gate.open();
+  releaser.join();
+  reclaimer.flush();
+  EXPECT_EQ(queued.load(), waited.load());
+  EXPECT_EQ(reclaimer.stats().reclaimed, 3u);
+  EXPECT_EQ(reclaimer.stats().destroyed_inline, 0u);
+}
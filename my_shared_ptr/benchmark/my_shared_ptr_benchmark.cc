@@ -0,0 +1,459 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "allocation_counter.h"
+#include "my_atomic_shared_ptr.h"
+#include "my_biased_ref_count.h"
+#include "my_deferred.h"
+#include "my_shared_ptr.h"
+
+namespace {
+
+// A small object, roughly the size of the values we usually share.
+struct Payload {
+  Payload() = default;
+  explicit Payload(int value) : a(value) {}
+  int a{0};
+  int b{0};
+  double c{0.0};
+};
+
+// Runs body once per iteration and reports the allocations it made as "allocs/op".
+template<typename Body>
+void RunCountingAllocations(benchmark::State& state, Body body) {
+  size_t before = ThreadAllocationCount();
+  for (auto _ : state) {
+    body();
+  }
+  state.counters["allocs/op"] = benchmark::Counter(
+      static_cast<double>(ThreadAllocationCount() - before), benchmark::Counter::kAvgIterations);
+}
+
+void BM_MySharedPtrFromRaw(benchmark::State& state) {
+  RunCountingAllocations(state, [] {
+    MySharedPtr<Payload> ptr(new Payload(1));
+    benchmark::DoNotOptimize(ptr.get());
+  });
+}
+BENCHMARK(BM_MySharedPtrFromRaw);
+
+void BM_MakeMyShared(benchmark::State& state) {
+  RunCountingAllocations(state, [] {
+    MySharedPtr<Payload> ptr = MakeMyShared<Payload>(1);
+    benchmark::DoNotOptimize(ptr.get());
+  });
+}
+BENCHMARK(BM_MakeMyShared);
+
+void BM_MySharedPtrNull(benchmark::State& state) {
+  RunCountingAllocations(state, [] {
+    MySharedPtr<Payload> ptr;
+    benchmark::DoNotOptimize(ptr.get());
+  });
+}
+BENCHMARK(BM_MySharedPtrNull);
+
+void BM_StdSharedPtrFromRaw(benchmark::State& state) {
+  RunCountingAllocations(state, [] {
+    std::shared_ptr<Payload> ptr(new Payload(1));
+    benchmark::DoNotOptimize(ptr.get());
+  });
+}
+BENCHMARK(BM_StdSharedPtrFromRaw);
+
+void BM_StdMakeShared(benchmark::State& state) {
+  RunCountingAllocations(state, [] {
+    std::shared_ptr<Payload> ptr = std::make_shared<Payload>(1);
+    benchmark::DoNotOptimize(ptr.get());
+  });
+}
+BENCHMARK(BM_StdMakeShared);
+
+// A stateless allocator that recycles blocks through a per-thread free list, one list per type it
+// is rebound to. Freed blocks are kept for reuse and never returned to the heap.
+template<typename T>
+struct FreeListAllocator {
+  using value_type = T;
+
+  FreeListAllocator() = default;
+  template<typename U>
+  FreeListAllocator(const FreeListAllocator<U>&) {}
+
+  T* allocate(size_t n) {
+    if (n == 1 && free_list != nullptr) {
+      FreeBlock* block = free_list;
+      free_list = block->next;
+      return reinterpret_cast<T*>(block);
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* ptr, size_t n) {
+    if (n != 1) {
+      std::allocator<T>().deallocate(ptr, n);
+      return;
+    }
+    auto* block = reinterpret_cast<FreeBlock*>(ptr);
+    block->next = free_list;
+    free_list = block;
+  }
+
+  template<typename U>
+  bool operator==(const FreeListAllocator<U>&) const { return true; }
+  template<typename U>
+  bool operator!=(const FreeListAllocator<U>&) const { return false; }
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+  static_assert(sizeof(T) >= sizeof(FreeBlock), "FreeListAllocator needs room for the link");
+  static inline thread_local FreeBlock* free_list = nullptr;
+};
+
+// After the first iteration the block comes off the free list, so steady state is allocation-free.
+void BM_AllocateMySharedFreeList(benchmark::State& state) {
+  RunCountingAllocations(state, [] {
+    MySharedPtr<Payload> ptr = AllocateMyShared<Payload>(FreeListAllocator<Payload>(), 1);
+    benchmark::DoNotOptimize(ptr.get());
+  });
+}
+BENCHMARK(BM_AllocateMySharedFreeList);
+
+void BM_StdAllocateSharedFreeList(benchmark::State& state) {
+  RunCountingAllocations(state, [] {
+    std::shared_ptr<Payload> ptr = std::allocate_shared<Payload>(FreeListAllocator<Payload>(), 1);
+    benchmark::DoNotOptimize(ptr.get());
+  });
+}
+BENCHMARK(BM_StdAllocateSharedFreeList);
+
+// Handing out a slice of a shared buffer: the aliasing constructor shares the buffer's control
+// block, while the alternative copies the slice into a buffer of its own.
+constexpr int kBufferSize = 64 * 1024;
+constexpr int kSliceSize = 4 * 1024;
+
+void BM_MySharedPtrAliasSlice(benchmark::State& state) {
+  MySharedPtr<char[]> buffer(new char[kBufferSize]());
+  int offset = 0;
+  RunCountingAllocations(state, [&] {
+    MySharedPtr<char[]> slice(buffer, buffer.get() + offset);
+    benchmark::DoNotOptimize(slice[0]);
+    offset = (offset + kSliceSize) % kBufferSize;
+  });
+}
+BENCHMARK(BM_MySharedPtrAliasSlice);
+
+void BM_MySharedPtrCopySlice(benchmark::State& state) {
+  MySharedPtr<char[]> buffer(new char[kBufferSize]());
+  int offset = 0;
+  RunCountingAllocations(state, [&] {
+    MySharedPtr<char[]> slice(new char[kSliceSize]);
+    std::copy_n(buffer.get() + offset, kSliceSize, slice.get());
+    benchmark::DoNotOptimize(slice[0]);
+    offset = (offset + kSliceSize) % kBufferSize;
+  });
+}
+BENCHMARK(BM_MySharedPtrCopySlice);
+
+// What an async callback captures to keep its object alive.
+struct Connection : MyEnableSharedFromThis<Connection> {
+  int id{0};
+};
+
+void BM_SharedFromThis(benchmark::State& state) {
+  MySharedPtr<Connection> connection = MakeMyShared<Connection>();
+  RunCountingAllocations(state, [&] {
+    MySharedPtr<Connection> captured = connection->shared_from_this();
+    benchmark::DoNotOptimize(captured.get());
+  });
+}
+BENCHMARK(BM_SharedFromThis);
+
+// Thread counts for the contention benchmarks scale from 1 up to the number of hardware threads.
+int MaxBenchmarkThreads() {
+  return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+MySharedPtr<Payload> shared_my_ptr = MakeMyShared<Payload>(1);
+std::shared_ptr<Payload> shared_std_ptr = std::make_shared<Payload>(1);
+
+// Every thread copies and destroys the same pointer, so all of them hit the same count. Note that
+// libstdc++ switches std::shared_ptr to plain increments while the process has a single thread,
+// so only the multi-threaded rows compare like with like.
+void BM_MySharedPtrCopyDestroy(benchmark::State& state) {
+  for (auto _ : state) {
+    MySharedPtr<Payload> copy(shared_my_ptr);
+    benchmark::DoNotOptimize(copy.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MySharedPtrCopyDestroy)->ThreadRange(1, MaxBenchmarkThreads())->UseRealTime();
+
+void BM_StdSharedPtrCopyDestroy(benchmark::State& state) {
+  for (auto _ : state) {
+    std::shared_ptr<Payload> copy(shared_std_ptr);
+    benchmark::DoNotOptimize(copy.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdSharedPtrCopyDestroy)->ThreadRange(1, MaxBenchmarkThreads())->UseRealTime();
+
+MyWeakPtr<Payload> weak_my_ptr(shared_my_ptr);
+std::weak_ptr<Payload> weak_std_ptr(shared_std_ptr);
+
+// Every thread locks the same weak pointer and drops the result, so all of them race on the
+// compare-and-swap that takes a strong reference.
+void BM_MyWeakPtrLock(benchmark::State& state) {
+  for (auto _ : state) {
+    MySharedPtr<Payload> locked = weak_my_ptr.lock();
+    benchmark::DoNotOptimize(locked.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MyWeakPtrLock)->ThreadRange(1, MaxBenchmarkThreads())->UseRealTime();
+
+void BM_StdWeakPtrLock(benchmark::State& state) {
+  for (auto _ : state) {
+    std::shared_ptr<Payload> locked = weak_std_ptr.lock();
+    benchmark::DoNotOptimize(locked.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdWeakPtrLock)->ThreadRange(1, MaxBenchmarkThreads())->UseRealTime();
+
+// Publish/read: one writer thread replaces the value once per millisecond while every benchmark
+// thread loads it. The writer is started by thread 0 before the timed loop and stopped after it.
+template<typename Slot>
+class PublishingWriter {
+public:
+  void start(Slot& slot) {
+    stop_.store(false);
+    thread_ = std::thread([this, &slot]() {
+      int version = 0;
+      while (!stop_.load()) {
+        slot.publish(++version);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+  }
+
+  void stop() {
+    stop_.store(true);
+    thread_.join();
+  }
+
+private:
+  std::atomic<bool> stop_{false};
+  std::thread thread_;
+};
+
+struct MyAtomicSlot {
+  void publish(int version) { slot.store(MakeMyShared<Payload>(version)); }
+  MySharedPtr<Payload> read() const { return slot.load(); }
+
+  MyAtomicSharedPtr<Payload> slot{MakeMyShared<Payload>(0)};
+};
+
+// What publishing looks like without MyAtomicSharedPtr: a mutex around the MySharedPtr itself.
+struct MutexSlot {
+  void publish(int version) {
+    MySharedPtr<Payload> next = MakeMyShared<Payload>(version);
+    std::lock_guard<std::mutex> lock(mutex);
+    slot.swap(next);
+  }
+  MySharedPtr<Payload> read() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return slot;
+  }
+
+  mutable std::mutex mutex;
+  MySharedPtr<Payload> slot = MakeMyShared<Payload>(0);
+};
+
+struct StdAtomicSlot {
+  void publish(int version) { std::atomic_store(&slot, std::make_shared<Payload>(version)); }
+  std::shared_ptr<Payload> read() const { return std::atomic_load(&slot); }
+
+  std::shared_ptr<Payload> slot = std::make_shared<Payload>(0);
+};
+
+template<typename Slot>
+void BM_PublishRead(benchmark::State& state) {
+  static Slot slot;
+  static PublishingWriter<Slot> writer;
+  if (state.thread_index() == 0) {
+    writer.start(slot);
+  }
+  for (auto _ : state) {
+    auto snapshot = slot.read();
+    benchmark::DoNotOptimize(snapshot->a);
+  }
+  if (state.thread_index() == 0) {
+    writer.stop();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_PublishRead, MyAtomicSlot)->ThreadRange(1, MaxBenchmarkThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PublishRead, MutexSlot)->ThreadRange(1, MaxBenchmarkThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PublishRead, StdAtomicSlot)->ThreadRange(1, MaxBenchmarkThreads())->UseRealTime();
+
+// Tree workload: build a tree of shared nodes, then walk it with an explicit stack of node pointers,
+// so every visit copies one pointer and destroys it again. Each *Tree struct names the pointer
+// type under test and how to make one.
+struct SingleThreadedTree {
+  template<typename T>
+  using Ptr = MySharedPtr<T, SingleThreaded>;
+
+  template<typename T, typename... Args>
+  static Ptr<T> Make(Args&&... args) {
+    return MakeMyShared<T, SingleThreaded>(std::forward<Args>(args)...);
+  }
+};
+
+struct MultiThreadedTree {
+  template<typename T>
+  using Ptr = MySharedPtr<T, MultiThreaded>;
+
+  template<typename T, typename... Args>
+  static Ptr<T> Make(Args&&... args) {
+    return MakeMyShared<T, MultiThreaded>(std::forward<Args>(args)...);
+  }
+};
+
+struct StdTree {
+  template<typename T>
+  using Ptr = std::shared_ptr<T>;
+
+  template<typename T, typename... Args>
+  static Ptr<T> Make(Args&&... args) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+};
+
+template<typename Tree>
+struct TreeNode {
+  explicit TreeNode(int v) : value(v) {}
+  int value;
+  std::vector<typename Tree::template Ptr<TreeNode>> children;
+};
+
+template<typename Tree>
+typename Tree::template Ptr<TreeNode<Tree>> BuildTree(int depth, int fanout) {
+  auto node = Tree::template Make<TreeNode<Tree>>(depth);
+  if (depth > 0) {
+    for (int i = 0; i < fanout; ++i) {
+      node->children.push_back(BuildTree<Tree>(depth - 1, fanout));
+    }
+  }
+  return node;
+}
+
+template<typename Tree>
+void BM_TreeWalk(benchmark::State& state) {
+  using NodePtr = typename Tree::template Ptr<TreeNode<Tree>>;
+  NodePtr root = BuildTree<Tree>(static_cast<int>(state.range(0)), 4);
+  std::vector<NodePtr> stack;
+  int64_t visited = 0;
+  for (auto _ : state) {
+    int64_t sum = 0;
+    stack.push_back(root);
+    while (!stack.empty()) {
+      NodePtr node = std::move(stack.back());
+      stack.pop_back();
+      sum += node->value;
+      for (const NodePtr& child : node->children) {
+        stack.push_back(child);
+      }
+      ++visited;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(visited);
+}
+BENCHMARK_TEMPLATE(BM_TreeWalk, SingleThreadedTree)->Arg(8);
+BENCHMARK_TEMPLATE(BM_TreeWalk, MultiThreadedTree)->Arg(8);
+BENCHMARK_TEMPLATE(BM_TreeWalk, StdTree)->Arg(8);
+
+// Scaling of the Biased policy on 1 to 64 threads. In the first pair, every thread copies an object
+// it created itself; in the second, every thread copies one global object, either directly or
+// through a biased handle it took once before the timed loop.
+template<typename Policy>
+void BM_CopyOwnObject(benchmark::State& state) {
+  MySharedPtr<Payload, Policy> own = MakeMyShared<Payload, Policy>(1);
+  for (auto _ : state) {
+    MySharedPtr<Payload, Policy> copy(own);
+    benchmark::DoNotOptimize(copy.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_CopyOwnObject, MultiThreaded)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CopyOwnObject, Biased)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_CopyGlobalObject(benchmark::State& state) {
+  for (auto _ : state) {
+    MySharedPtr<Payload> copy(shared_my_ptr);
+    benchmark::DoNotOptimize(copy.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CopyGlobalObject)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_CopyGlobalObjectBiasedHandle(benchmark::State& state) {
+  MySharedPtr<Payload, Biased> handle = MakeMyBiasedHandle(shared_my_ptr);
+  for (auto _ : state) {
+    MySharedPtr<Payload, Biased> copy(handle);
+    benchmark::DoNotOptimize(copy.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CopyGlobalObjectBiasedHandle)->ThreadRange(1, 64)->UseRealTime();
+
+// Dropping the last reference to a graph of state.range(0) nodes. Only the release itself is timed:
+// with Deferred, the graph is destroyed by the reclaimer, which is flushed outside the timed region.
+// On a machine with few cores the reclaimer competes with the releasing thread, so compare the
+// CPU column, which is what the releasing thread itself spends.
+template<typename Policy>
+struct GraphNode {
+  std::vector<MySharedPtr<GraphNode, Policy>> children;
+};
+
+template<typename Policy>
+MySharedPtr<GraphNode<Policy>, Policy> BuildGraph(int64_t nodes) {
+  MySharedPtr<GraphNode<Policy>, Policy> root = MakeMyShared<GraphNode<Policy>, Policy>();
+  root->children.reserve(static_cast<size_t>(nodes));
+  for (int64_t i = 1; i < nodes; ++i) {
+    root->children.push_back(MakeMyShared<GraphNode<Policy>, Policy>());
+  }
+  return root;
+}
+
+template<typename Policy>
+void BM_ReleaseGraph(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    MySharedPtr<GraphNode<Policy>, Policy> root = BuildGraph<Policy>(state.range(0));
+    state.ResumeTiming();
+    root = MySharedPtr<GraphNode<Policy>, Policy>();
+    state.PauseTiming();
+    if constexpr (std::is_same_v<Policy, Deferred>) {
+      Deferred::reclaimer().flush();
+    }
+    state.ResumeTiming();
+  }
+  if constexpr (std::is_same_v<Policy, Deferred>) {
+    MyReclaimer::Stats stats = Deferred::reclaimer().stats();
+    state.counters["max_queue_depth"] = static_cast<double>(stats.max_queue_depth);
+    state.counters["mean_reclaim_us"] =
+        std::chrono::duration<double, std::micro>(stats.total_latency).count() / static_cast<double>(stats.batches);
+  }
+}
+BENCHMARK_TEMPLATE(BM_ReleaseGraph, MultiThreaded)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_ReleaseGraph, Deferred)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+}  // namespace
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "my_shared_ptr.h"
+
+/**
+ * @brief An atomic slot holding a MySharedPtr, for publishing data that many threads read.
+ *
+ * MyAtomicSharedPtr offers load, store, exchange and compare_exchange in the style of C++20
+ * std::atomic<std::shared_ptr>. It is lock-free: readers never block, whatever the writers do.
+ *
+ * Each stored value lives in a small immutable node. The atomic word packs a pointer to the
+ * current node with a "local" count of readers that are in the middle of a load (split
+ * reference counting):
+ *  - A reader bumps the local count with one fetch_add, which also tells it the current node and
+ *    keeps that node alive. It copies the MySharedPtr out of the node and then removes its bump.
+ *  - A writer swaps in a new node with the local count reset to zero. The bumps of readers still
+ *    working on the old node move into the old node's own reference count, and each of those
+ *    readers drops one node reference instead of removing its bump. The node is freed once the
+ *    last of them is done.
+ *
+ * The local count uses the top 16 bits of the word, so up to 65535 loads may be in flight at the
+ * same time. That relies on user-space addresses fitting in 48 bits, as on x86-64 and AArch64.
+ *
+ * @tparam T The type of the object managed by the stored MySharedPtr.
+ */
+template<typename T>
+class MyAtomicSharedPtr {
+public:
+  /**
+   * @brief Constructs a slot holding a null MySharedPtr.
+   */
+  MyAtomicSharedPtr() noexcept : word_(0) {}
+
+  /**
+   * @brief Constructs a slot holding the given value.
+   *
+   * @param desired The initial value.
+   */
+  MyAtomicSharedPtr(MySharedPtr<T> desired) : word_(pack(make_node(std::move(desired)), 0)) {}
+
+  MyAtomicSharedPtr(const MyAtomicSharedPtr&) = delete;
+  MyAtomicSharedPtr& operator=(const MyAtomicSharedPtr&) = delete;
+
+  /**
+   * @brief Destroys the slot, releasing the stored value. Must not race with any other operation.
+   */
+  ~MyAtomicSharedPtr() {
+    retire(word_.load(std::memory_order_acquire));
+  }
+
+  /**
+   * @brief Atomically reads the stored value.
+   *
+   * @return A copy of the stored MySharedPtr.
+   */
+  MySharedPtr<T> load() const noexcept {
+    if (node_of(word_.load(std::memory_order_acquire)) == nullptr) {
+      return MySharedPtr<T>();
+    }
+    Node* node = node_of(word_.fetch_add(kLocalRef, std::memory_order_acquire));
+    MySharedPtr<T> result = node ? node->value : MySharedPtr<T>();
+    unbump(node);
+    return result;
+  }
+
+  /**
+   * @brief Atomically reads the stored value. Same as load().
+   */
+  operator MySharedPtr<T>() const noexcept {
+    return load();
+  }
+
+  /**
+   * @brief Atomically replaces the stored value.
+   *
+   * @param desired The new value.
+   */
+  void store(MySharedPtr<T> desired) {
+    retire(word_.exchange(pack(make_node(std::move(desired)), 0), std::memory_order_acq_rel));
+  }
+
+  /**
+   * @brief Atomically replaces the stored value and returns the previous one.
+   *
+   * @param desired The new value.
+   * @return The value stored before the call.
+   */
+  MySharedPtr<T> exchange(MySharedPtr<T> desired) {
+    uint64_t old_word = word_.exchange(pack(make_node(std::move(desired)), 0), std::memory_order_acq_rel);
+    Node* old_node = node_of(old_word);
+    // Readers may still be copying from the old node, so copy out of it rather than moving.
+    MySharedPtr<T> previous = old_node ? old_node->value : MySharedPtr<T>();
+    retire(old_word);
+    return previous;
+  }
+
+  /**
+   * @brief Replaces the stored value with desired if it is equivalent to expected.
+   *
+   * Two values are equivalent if they point at the same object and share the same control block.
+   * On failure, expected is updated to the current value.
+   *
+   * @param expected The value the caller believes is stored.
+   * @param desired The value to store if the belief holds.
+   * @return true if the value was replaced, false otherwise.
+   */
+  bool compare_exchange_strong(MySharedPtr<T>& expected, MySharedPtr<T> desired) {
+    Node* desired_node = make_node(std::move(desired));
+    while (true) {
+      // Bump the local count so that the current node stays alive while we compare against it.
+      uint64_t word = word_.fetch_add(kLocalRef, std::memory_order_acquire) + kLocalRef;
+      Node* node = node_of(word);
+      if (!equivalent(node, expected)) {
+        expected = node ? node->value : MySharedPtr<T>();
+        unbump(node);
+        delete desired_node;
+        return false;
+      }
+      while (node_of(word) == node) {
+        if (word_.compare_exchange_weak(word, pack(desired_node, 0), std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+          // Our own bump is among the local references of the retired word; drop it with the rest.
+          retire(word - kLocalRef);
+          return true;
+        }
+      }
+      // Another writer replaced the node after we compared; start over against the new value.
+      unbump(node);
+    }
+  }
+
+  /**
+   * @brief Same as compare_exchange_strong(); this implementation never fails spuriously.
+   */
+  bool compare_exchange_weak(MySharedPtr<T>& expected, MySharedPtr<T> desired) {
+    return compare_exchange_strong(expected, std::move(desired));
+  }
+
+  /**
+   * @brief Checks whether operations on this slot are lock-free.
+   *
+   * @return true if the packed word is a lock-free atomic on this platform.
+   */
+  bool is_lock_free() const noexcept {
+    return word_.is_lock_free();
+  }
+
+private:
+  /**
+   * @brief An immutable holder for one stored value.
+   */
+  struct Node {
+    explicit Node(MySharedPtr<T> v) : value(std::move(v)) {}
+
+    MySharedPtr<T> value;         ///< The stored value.
+    std::atomic<size_t> refs{1};  ///< One for the slot while installed, plus one per retired local bump.
+  };
+
+  static_assert(sizeof(void*) == sizeof(uint64_t), "MyAtomicSharedPtr packs pointers into 64 bits");
+
+  static constexpr int kPointerBits = 48;
+  static constexpr uint64_t kPointerMask = (uint64_t{1} << kPointerBits) - 1;
+  static constexpr uint64_t kLocalRef = uint64_t{1} << kPointerBits;
+
+  static uint64_t pack(Node* node, uint64_t local) noexcept {
+    return reinterpret_cast<uint64_t>(node) | (local << kPointerBits);
+  }
+
+  static Node* node_of(uint64_t word) noexcept {
+    return reinterpret_cast<Node*>(word & kPointerMask);
+  }
+
+  static uint64_t local_of(uint64_t word) noexcept {
+    return word >> kPointerBits;
+  }
+
+  /**
+   * @brief Wraps a value in a node. A null value needs no node and allocates nothing.
+   */
+  static Node* make_node(MySharedPtr<T> value) {
+    return value.ptr_ == nullptr && value.cb_ == nullptr ? nullptr : new Node(std::move(value));
+  }
+
+  static bool equivalent(const Node* node, const MySharedPtr<T>& expected) noexcept {
+    if (node == nullptr) {
+      return expected.ptr_ == nullptr && expected.cb_ == nullptr;
+    }
+    return node->value.ptr_ == expected.ptr_ && node->value.cb_ == expected.cb_;
+  }
+
+  static void release_node(Node* node) noexcept {
+    if (node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete node;
+    }
+  }
+
+  /**
+   * @brief Gives up the slot's hold on a word that has just been swapped out.
+   *
+   * The local bumps of readers still using the node become node references, and the slot's own
+   * reference is dropped.
+   */
+  static void retire(uint64_t word) noexcept {
+    Node* node = node_of(word);
+    if (node == nullptr) {
+      return;
+    }
+    uint64_t local = local_of(word);
+    if (local == 0) {
+      release_node(node);
+    } else if (local > 1) {
+      node->refs.fetch_add(local - 1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Removes a reader's local bump on node, or drops the node reference it was turned into.
+   */
+  void unbump(Node* node) const noexcept {
+    uint64_t word = word_.load(std::memory_order_relaxed);
+    while (node_of(word) == node && local_of(word) > 0) {
+      if (word_.compare_exchange_weak(word, word - kLocalRef, std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+        return;
+      }
+    }
+    // A writer swapped the node out and turned our bump into a reference on the node.
+    if (node != nullptr) {
+      release_node(node);
+    }
+  }
+
+  mutable std::atomic<uint64_t> word_;  ///< Current node in the low 48 bits, local count on top.
+};
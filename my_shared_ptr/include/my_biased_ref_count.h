@@ -0,0 +1,372 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "my_shared_ptr.h"
+
+/**
+ * @brief Biased reference counting policy for MySharedPtr.
+ *
+ * Each control block is biased towards the thread that creates it, its owner. The owner counts its
+ * references in a private counter that it updates without read-modify-write instructions, so its
+ * copies and releases never move the block's cache line between cores. Every other thread counts
+ * in a shared atomic counter, which may go negative when references made by the owner are released
+ * elsewhere.
+ *
+ * The two counters only need to be merged when their sum could reach zero:
+ *  - When the owner's counter drops to zero, the owner merges at once.
+ *  - When another thread takes the shared counter below zero, it queues the block with the owner,
+ *    which merges the next time it releases a biased reference, creates a biased block or calls
+ *    MyFlushBiasedCounts(). Until then the object stays alive, so threads that create biased
+ *    objects should not sit idle forever while others release them.
+ * After merging, the block behaves like a MultiThreaded one. Blocks whose owner has exited are
+ * merged by whichever thread queues them.
+ *
+ * Biased pays off for objects copied mostly by one thread. For an object copied by every worker,
+ * such as a global configuration, give each worker its own biased handle with MakeMyBiasedHandle,
+ * so that each worker counts on its own counter and touches the shared one only when its handle
+ * goes away.
+ *
+ * Unlike MultiThreaded and SingleThreaded, Biased is not a set of count operations: it selects a
+ * specialization of MySharedControlBlock.
+ */
+struct Biased {};
+
+template<>
+class MySharedControlBlock<Biased>;
+
+/**
+ * @brief Per-thread state of the Biased policy: the queue of blocks waiting for the thread to merge.
+ *
+ * Created the first time a thread creates a biased block and kept alive by that thread and by every
+ * block it owns. The queue is a lock-free stack linked through the blocks themselves, so queueing
+ * never allocates.
+ */
+class MyBiasedThread {
+public:
+  MyBiasedThread(const MyBiasedThread&) = delete;
+  MyBiasedThread& operator=(const MyBiasedThread&) = delete;
+
+  /**
+   * @brief Retrieves the calling thread's state without creating it.
+   *
+   * @return The state, or nullptr if the thread has not created a biased block or has exited.
+   */
+  static MyBiasedThread* current() noexcept {
+    return current_;
+  }
+
+  /**
+   * @brief Retrieves the calling thread's state, creating it on first use.
+   *
+   * @return The state, or nullptr if the thread is already running its thread-exit destructors.
+   */
+  static MyBiasedThread* attach();
+
+  void acquire() noexcept {
+    refs_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void release() noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  /**
+   * @brief Queues a block for the owner to merge. Called by non-owning threads.
+   *
+   * @return false if the owner has exited, in which case the caller must merge the block itself.
+   */
+  bool enqueue(MySharedControlBlock<Biased>* block) noexcept;
+
+  /**
+   * @brief Merges the queued blocks. Called by the owning thread only.
+   */
+  void merge_pending() noexcept {
+    if (head_.load(std::memory_order_relaxed) != nullptr) {
+      merge_list(head_.exchange(nullptr, std::memory_order_acquire));
+    }
+  }
+
+private:
+  /**
+   * @brief Merges the thread's queue when it exits and marks it closed.
+   */
+  struct ExitHook {
+    ~ExitHook() {
+      MyBiasedThread* state = current_;
+      current_ = nullptr;
+      exited_ = true;
+      state->merge_list(state->head_.exchange(closed(), std::memory_order_acq_rel));
+      state->release();
+    }
+  };
+
+  MyBiasedThread() = default;
+
+  static MySharedControlBlock<Biased>* closed() noexcept {
+    return reinterpret_cast<MySharedControlBlock<Biased>*>(uintptr_t{1});
+  }
+
+  static void merge_list(MySharedControlBlock<Biased>* block) noexcept;
+
+  static inline thread_local MyBiasedThread* current_ = nullptr;
+  static inline thread_local bool exited_ = false;
+
+  std::atomic<size_t> refs_{1};                                ///< The thread itself plus each block it owns.
+  std::atomic<MySharedControlBlock<Biased>*> head_{nullptr};  ///< Queued blocks, or closed() after exit.
+};
+
+/**
+ * @brief Control block for the Biased policy.
+ *
+ * The strong count is split into a biased counter, written only by the owner, and a shared word
+ * holding a signed count in steps of kOne plus the kMerged and kQueued flags. The weak count is a
+ * plain atomic, as weak references are rare.
+ */
+template<>
+class MySharedControlBlock<Biased> {
+public:
+  /**
+   * @brief Creates a block biased towards the calling thread, holding one strong reference.
+   *
+   * During thread exit, when biasing is no longer possible, the block starts out merged.
+   */
+  MySharedControlBlock() : thread_(MyBiasedThread::attach()) {
+    if (thread_ == nullptr) {
+      shared_.store(kOne | kMerged, std::memory_order_relaxed);
+      return;
+    }
+    thread_->acquire();
+    thread_->merge_pending();
+    owner_.store(thread_, std::memory_order_relaxed);
+    biased_.store(1, std::memory_order_relaxed);
+  }
+
+  MySharedControlBlock(const MySharedControlBlock&) = delete;
+  MySharedControlBlock& operator=(const MySharedControlBlock&) = delete;
+
+  virtual ~MySharedControlBlock() {
+    if (thread_ != nullptr) {
+      thread_->release();
+    }
+  }
+
+  /**
+   * @brief Increments the strong count.
+   */
+  void add_ref() noexcept {
+    if (is_owner()) {
+      biased_.store(biased_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    } else {
+      shared_.fetch_add(kOne, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Increments the strong count unless the object has already been destroyed.
+   *
+   * @return true if a strong reference was taken.
+   */
+  bool try_add_ref() noexcept {
+    if (is_owner()) {
+      // An unmerged block still has its object.
+      add_ref();
+      return true;
+    }
+    int64_t word = shared_.load(std::memory_order_relaxed);
+    do {
+      if ((word & kMerged) != 0 && count_of(word) == 0) {
+        return false;
+      }
+    } while (!shared_.compare_exchange_weak(word, word + kOne, std::memory_order_acquire,
+                                            std::memory_order_relaxed));
+    return true;
+  }
+
+  /**
+   * @brief Decrements the strong count and destroys the object if no owners remain.
+   */
+  void release() noexcept {
+    MyBiasedThread* thread = MyBiasedThread::current();
+    if (thread != nullptr && owner_.load(std::memory_order_relaxed) == thread) {
+      int64_t biased = biased_.load(std::memory_order_relaxed) - 1;
+      biased_.store(biased, std::memory_order_relaxed);
+      if (biased == 0 && merge()) {
+        release_last();
+      }
+      thread->merge_pending();
+      return;
+    }
+    int64_t word = shared_.fetch_sub(kOne, std::memory_order_acq_rel) - kOne;
+    if ((word & kMerged) != 0) {
+      if (count_of(word) == 0) {
+        release_last();
+      }
+    } else if (count_of(word) < 0) {
+      queue_for_merge(word);
+    }
+  }
+
+  /**
+   * @brief Increments the weak count.
+   */
+  void add_weak() noexcept {
+    weak_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Decrements the weak count and frees this block once nothing refers to it any more.
+   */
+  void release_weak() noexcept {
+    if (weak_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      destroy();
+    }
+  }
+
+  /**
+   * @brief Retrieves the current number of owners. Approximate while other threads hold references.
+   */
+  size_t use_count() const noexcept {
+    int64_t count = biased_.load(std::memory_order_relaxed) + count_of(shared_.load(std::memory_order_acquire));
+    return count > 0 ? static_cast<size_t>(count) : 0;
+  }
+
+protected:
+  virtual void dispose() noexcept = 0;
+
+  virtual void destroy() noexcept {
+    delete this;
+  }
+
+private:
+  friend class MyBiasedThread;
+
+  static constexpr int64_t kMerged = 1;  ///< The biased counter has been folded into the shared one.
+  static constexpr int64_t kQueued = 2;  ///< The block is, or has been, queued with its owner.
+  static constexpr int64_t kOne = 4;     ///< One reference in the shared word.
+
+  static int64_t count_of(int64_t word) noexcept {
+    return word >> 2;
+  }
+
+  bool is_owner() const noexcept {
+    MyBiasedThread* thread = MyBiasedThread::current();
+    return thread != nullptr && owner_.load(std::memory_order_relaxed) == thread;
+  }
+
+  /**
+   * @brief Folds the biased counter into the shared one. Called on an unmerged block, by the owner
+   * or on behalf of an owner that has exited.
+   *
+   * @return true if no references remain.
+   */
+  bool merge() noexcept {
+    int64_t biased = biased_.load(std::memory_order_relaxed);
+    biased_.store(0, std::memory_order_relaxed);
+    owner_.store(nullptr, std::memory_order_relaxed);
+    int64_t delta = biased * kOne + kMerged;
+    return count_of(shared_.fetch_add(delta, std::memory_order_acq_rel) + delta) == 0;
+  }
+
+  /**
+   * @brief Merges a block taken off a queue and drops the weak reference the queue held.
+   */
+  void merge_queued() noexcept {
+    if (owner_.load(std::memory_order_relaxed) != nullptr && merge()) {
+      release_last();
+    }
+    release_weak();
+  }
+
+  /**
+   * @brief Hands the block to its owner after the shared count went negative, unless another
+   * thread has already done so or the owner has merged in the meantime.
+   */
+  void queue_for_merge(int64_t word) noexcept {
+    while ((word & (kMerged | kQueued)) == 0) {
+      if (shared_.compare_exchange_weak(word, word | kQueued, std::memory_order_relaxed,
+                                        std::memory_order_relaxed)) {
+        // The queue keeps the block alive until the owner gets to it.
+        add_weak();
+        if (!thread_->enqueue(this)) {
+          merge_queued();
+        }
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Destroys the object once the last owner is gone and gives up the owners' weak reference.
+   */
+  void release_last() noexcept {
+    dispose();
+    release_weak();
+  }
+
+  MyBiasedThread* const thread_;                   ///< The creating thread, kept alive by this block.
+  std::atomic<MyBiasedThread*> owner_{nullptr};    ///< The creating thread until merged, then nullptr.
+  std::atomic<int64_t> biased_{0};                 ///< The owner's references.
+  std::atomic<int64_t> shared_{0};                 ///< Other threads' references, in kOne steps, plus flags.
+  std::atomic<size_t> weak_count_{1};              ///< Number of MyWeakPtr instances, plus one while owned.
+  MySharedControlBlock* next_queued_{nullptr};     ///< Next block in the owner's queue.
+};
+
+inline MyBiasedThread* MyBiasedThread::attach() {
+  if (current_ == nullptr && !exited_) {
+    current_ = new MyBiasedThread();
+    thread_local ExitHook hook;
+  }
+  return current_;
+}
+
+inline bool MyBiasedThread::enqueue(MySharedControlBlock<Biased>* block) noexcept {
+  // Reading closed() with acquire ordering makes the exited owner's final biased count visible.
+  MySharedControlBlock<Biased>* head = head_.load(std::memory_order_acquire);
+  do {
+    if (head == closed()) {
+      return false;
+    }
+    block->next_queued_ = head;
+  } while (!head_.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_acquire));
+  return true;
+}
+
+inline void MyBiasedThread::merge_list(MySharedControlBlock<Biased>* block) noexcept {
+  while (block != nullptr) {
+    MySharedControlBlock<Biased>* next = block->next_queued_;
+    block->merge_queued();
+    block = next;
+  }
+}
+
+/**
+ * @brief Merges the blocks that other threads have queued with the calling thread.
+ *
+ * Owners also merge whenever they release a biased reference or create a biased block; call this
+ * from threads that do neither for long stretches, or before checking that objects were destroyed.
+ */
+inline void MyFlushBiasedCounts() noexcept {
+  if (MyBiasedThread* thread = MyBiasedThread::current()) {
+    thread->merge_pending();
+  }
+}
+
+/**
+ * @brief Creates a handle to shared that is biased towards the calling thread.
+ *
+ * The handle owns one reference to shared. Copies of it made on the calling thread are counted
+ * without atomic instructions and without touching shared's count.
+ *
+ * @param shared The object to hand out.
+ * @return A Biased pointer to the same object.
+ */
+template<typename T, typename Policy>
+MySharedPtr<T, Biased> MakeMyBiasedHandle(const MySharedPtr<T, Policy>& shared) {
+  MySharedPtr<MySharedPtr<T, Policy>, Biased> holder = MakeMyShared<MySharedPtr<T, Policy>, Biased>(shared);
+  T* ptr = holder->get();
+  return MySharedPtr<T, Biased>(std::move(holder), ptr);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "my_reclaimer.h"
+#include "my_shared_ptr.h"
+
+/**
+ * @brief Reference counting policy for MySharedPtr that destroys unowned objects in the background.
+ *
+ * Counts are maintained exactly as with MultiThreaded. When the last owner lets go, its control
+ * block is queued with reclaimer(), whose thread destroys queued objects in batches. Use it for
+ * objects whose destruction is expensive, such as large graphs, when they are released on
+ * latency-critical threads.
+ *
+ * reclaimer() belongs to this policy alone, so releases never queue behind objects handed to
+ * MyAsyncDeleter. It uses kDestroyInline: once 1024 blocks are waiting, the releasing thread
+ * destroys the object itself rather than stalling until the reclaimer catches up. Switching it
+ * to kBlock bounds the work a release can do, but then a release may wait for a whole batch.
+ *
+ * Objects owned by a Deferred pointer must be safe to destroy on another thread. MyWeakPtr
+ * observers see the object as expired as soon as the last owner is gone.
+ */
+struct Deferred : MultiThreaded {
+  /**
+   * @brief Retrieves the reclaimer that destroys objects released under this policy.
+   *
+   * Created on first use and never destroyed, like MyReclaimer::instance().
+   */
+  static MyReclaimer& reclaimer();
+
+  /**
+   * @brief Queues a block whose strong count has reached zero with reclaimer().
+   */
+  static void retire(MySharedControlBlock<Deferred>* block) noexcept;
+};
+
+template<>
+struct MyDefersDestruction<Deferred> : std::true_type {};
+
+inline MyReclaimer& Deferred::reclaimer() {
+  static MyReclaimer* reclaimer = new MyReclaimer(1024, MyBackpressure::kDestroyInline);
+  return *reclaimer;
+}
+
+inline void Deferred::retire(MySharedControlBlock<Deferred>* block) noexcept {
+  reclaimer().retire(block, [](void* released) {
+    static_cast<MySharedControlBlock<Deferred>*>(released)->release_last();
+  });
+}
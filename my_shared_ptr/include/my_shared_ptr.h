@@ -1,42 +1,499 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <iostream>
-#include <mutex>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Reference counting policy for MySharedPtr that may be shared across threads (like Rust's Arc).
+ *
+ * Counts are atomics updated without locks. This is the default policy.
+ */
+struct MultiThreaded {
+  using Count = std::atomic<size_t>;
+
+  /**
+   * @brief Increments a count. The caller already holds a reference, so no ordering is needed.
+   */
+  static void increment(Count& count) noexcept {
+    count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Increments a count unless it has already dropped to zero.
+   *
+   * @return true if the count was incremented.
+   */
+  static bool increment_if_nonzero(Count& count) noexcept {
+    size_t value = count.load(std::memory_order_relaxed);
+    while (value != 0) {
+      if (count.compare_exchange_weak(value, value + 1, std::memory_order_acquire,
+                                      std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Decrements a count.
+   *
+   * The decrement releases the caller's writes and, when it takes the count to zero, acquires
+   * every other holder's writes so that the caller can safely destroy what the count protects.
+   *
+   * @return true if the count reached zero.
+   */
+  static bool decrement(Count& count) noexcept {
+    return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  /**
+   * @brief Reads a count. No ordering: the value is only a snapshot.
+   */
+  static size_t load(const Count& count) noexcept {
+    return count.load(std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief Reference counting policy for MySharedPtr that never crosses threads (like Rust's Rc).
+ *
+ * Counts are plain integers, so copies and releases cost an ordinary increment and decrement.
+ * Every MySharedPtr and MyWeakPtr sharing an object must stay on one thread.
+ */
+struct SingleThreaded {
+  using Count = size_t;
+
+  static void increment(Count& count) noexcept {
+    ++count;
+  }
+
+  static bool increment_if_nonzero(Count& count) noexcept {
+    if (count == 0) {
+      return false;
+    }
+    ++count;
+    return true;
+  }
+
+  static bool decrement(Count& count) noexcept {
+    return --count == 0;
+  }
+
+  static size_t load(const Count& count) noexcept {
+    return count;
+  }
+};
+
+/**
+ * @brief Tells whether a reference counting policy defers destruction of unowned objects.
+ *
+ * When true, the last owner does not destroy the object itself but passes the control block to
+ * `Policy::retire()`, which must eventually call release_last() on it.
+ */
+template<typename Policy>
+struct MyDefersDestruction : std::false_type {};
+
+/**
+ * @brief The shared bookkeeping behind every MySharedPtr and MyWeakPtr that refer to the same object.
+ *
+ * The control block holds two counts, both updated as the Policy dictates. The strong count is the
+ * number of MySharedPtr owners; the object is destroyed when it reaches zero. The weak count is the
+ * number of MyWeakPtr observers plus one for all the owners together; the block itself is freed when
+ * it reaches zero. Derived blocks decide where the managed object lives, how it is destroyed and
+ * where the block's own memory comes from.
+ *
+ * @tparam Policy The reference counting policy, MultiThreaded or SingleThreaded.
+ */
+template<typename Policy>
+class MySharedControlBlock {
+public:
+  MySharedControlBlock() = default;
+  MySharedControlBlock(const MySharedControlBlock&) = delete;
+  MySharedControlBlock& operator=(const MySharedControlBlock&) = delete;
+  virtual ~MySharedControlBlock() = default;
+
+  /**
+   * @brief Increments the strong count.
+   */
+  void add_ref() noexcept {
+    Policy::increment(count_);
+  }
+
+  /**
+   * @brief Increments the strong count unless it has already dropped to zero.
+   *
+   * Used by MyWeakPtr::lock(), whose caller holds only a weak reference.
+   *
+   * @return true if a strong reference was taken, false if the object is already destroyed.
+   */
+  bool try_add_ref() noexcept {
+    return Policy::increment_if_nonzero(count_);
+  }
+
+  /**
+   * @brief Decrements the strong count and destroys the object if no owners remain.
+   *
+   * If the Policy defers destruction, the last owner hands the block to Policy::retire() instead.
+   */
+  void release() noexcept {
+    if (Policy::decrement(count_)) {
+      if constexpr (MyDefersDestruction<Policy>::value) {
+        Policy::retire(this);
+      } else {
+        release_last();
+      }
+    }
+  }
+
+  /**
+   * @brief Destroys the object after the strong count has reached zero, then gives up the weak
+   * reference held on behalf of all owners, which frees the block if nobody observes it.
+   *
+   * Called by release(), or later by whoever the Policy handed the block to.
+   */
+  void release_last() noexcept {
+    dispose();
+    // Without observers, the owners hold the only weak reference and nobody can add one any
+    // more, so the block can be freed without another read-modify-write.
+    if (Policy::load(weak_count_) == 1) {
+      // Pairs with the release in the decrement of the last observer that let go, so that its
+      // accesses to the block happen before the block is freed.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      destroy();
+    } else {
+      release_weak();
+    }
+  }
+
+  /**
+   * @brief Increments the weak count.
+   */
+  void add_weak() noexcept {
+    Policy::increment(weak_count_);
+  }
+
+  /**
+   * @brief Decrements the weak count and frees this block once nothing refers to it any more.
+   */
+  void release_weak() noexcept {
+    if (Policy::decrement(weak_count_)) {
+      destroy();
+    }
+  }
+
+  /**
+   * @brief Retrieves the current number of owners.
+   *
+   * With the MultiThreaded policy, the value may be stale by the time it is returned if other
+   * threads are copying or destroying owners concurrently.
+   *
+   * @return The strong count.
+   */
+  size_t use_count() const noexcept {
+    return Policy::load(count_);
+  }
+
+protected:
+  /**
+   * @brief Destroys the managed object. Called exactly once, when the strong count reaches zero.
+   */
+  virtual void dispose() noexcept = 0;
+
+  /**
+   * @brief Frees this block. Called exactly once, when the weak count reaches zero.
+   *
+   * Blocks created with plain `new` use the default; blocks that come from an allocator override
+   * it to hand their memory back to that allocator.
+   */
+  virtual void destroy() noexcept {
+    delete this;
+  }
+
+private:
+  typename Policy::Count count_{1};       ///< Number of MySharedPtr instances sharing the object.
+  typename Policy::Count weak_count_{1};  ///< Number of MyWeakPtr instances, plus one while count_ > 0.
+};
+
+/**
+ * @brief Deletes an object allocated with `new`, or an array allocated with `new[]` if T is an
+ * array type.
+ */
+template<typename T>
+void MyDeleteOwned(std::remove_extent_t<T>* ptr) noexcept {
+  if constexpr (std::is_array_v<T>) {
+    delete[] ptr;
+  } else {
+    delete ptr;
+  }
+}
+
+/**
+ * @brief Control block for an object that was allocated separately by the caller with `new`,
+ * or for an array allocated with `new[]` when T is an array type.
+ *
+ * @tparam T The type of the managed object, possibly an array of unknown bound.
+ * @tparam Policy The reference counting policy.
+ */
+template<typename T, typename Policy>
+class MyPointerControlBlock : public MySharedControlBlock<Policy> {
+public:
+  explicit MyPointerControlBlock(std::remove_extent_t<T>* ptr) : ptr_(ptr) {}
+
+protected:
+  void dispose() noexcept override {
+    MyDeleteOwned<T>(ptr_);
+  }
+
+private:
+  std::remove_extent_t<T>* ptr_;  ///< Pointer to the managed object or the first array element.
+};
+
+/**
+ * @brief Allocates and constructs a control block with the given allocator.
+ *
+ * The allocator is rebound to the block type; the block receives a copy of the caller's allocator
+ * as its first constructor argument so that it can free itself later. Allocators are expected to
+ * hand out plain pointers.
+ *
+ * @tparam Block The control block type to create.
+ * @param alloc The allocator that provides the block's memory.
+ * @param args Further arguments forwarded to the constructor of Block.
+ * @return The new control block.
+ */
+template<typename Block, typename Alloc, typename... Args>
+Block* MyAllocateControlBlock(const Alloc& alloc, Args&&... args) {
+  using BlockAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Block>;
+  BlockAlloc block_alloc(alloc);
+  Block* block = std::allocator_traits<BlockAlloc>::allocate(block_alloc, 1);
+  try {
+    ::new (static_cast<void*>(block)) Block(alloc, std::forward<Args>(args)...);
+  } catch (...) {
+    std::allocator_traits<BlockAlloc>::deallocate(block_alloc, block, 1);
+    throw;
+  }
+  return block;
+}
+
+/**
+ * @brief Destroys a control block created by MyAllocateControlBlock and frees its memory.
+ *
+ * @param block The block to free.
+ * @param alloc The allocator the block was created with; copied before the block is destroyed.
+ */
+template<typename Block, typename Alloc>
+void MyDeallocateControlBlock(Block* block, const Alloc& alloc) noexcept {
+  using BlockAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Block>;
+  BlockAlloc block_alloc(alloc);
+  block->~Block();
+  std::allocator_traits<BlockAlloc>::deallocate(block_alloc, block, 1);
+}
+
+/**
+ * @brief Control block for a caller-allocated object that is released with a custom deleter.
+ *
+ * The block itself comes from Alloc. Stateless deleters and allocators take no space in it.
+ *
+ * @tparam T The type of the managed object.
+ * @tparam Deleter A callable invoked with the object pointer once the last owner is gone.
+ * @tparam Alloc The allocator the block is allocated with.
+ * @tparam Policy The reference counting policy.
+ */
+template<typename T, typename Deleter, typename Alloc, typename Policy>
+class MyDeleterControlBlock : public MySharedControlBlock<Policy> {
+public:
+  MyDeleterControlBlock(const Alloc& alloc, T* ptr, Deleter deleter)
+      : ptr_(ptr), deleter_(std::move(deleter)), alloc_(alloc) {}
+
+protected:
+  void dispose() noexcept override {
+    deleter_(ptr_);
+  }
+
+  void destroy() noexcept override {
+    MyDeallocateControlBlock(this, alloc_);
+  }
+
+private:
+  T* ptr_;                                ///< Pointer to the managed object.
+  [[no_unique_address]] Deleter deleter_;  ///< Releases the managed object.
+  [[no_unique_address]] Alloc alloc_;      ///< Allocator that owns this block's memory.
+};
+
+/**
+ * @brief Control block that stores the managed object inline, right after the reference counts.
+ *
+ * Used by MakeMyShared and AllocateMyShared so that the object and its bookkeeping come from a
+ * single allocation and usually share a cache line. While MyWeakPtr observers remain, the destroyed
+ * object's storage stays allocated along with the block. The block takes the alignment of T, so a
+ * type declared with alignas(64) gets a cache-line-aligned block; other types stay on the plain
+ * malloc path, which is several times cheaper than an over-aligned allocation.
+ *
+ * @tparam T The type of the managed object.
+ * @tparam Alloc The allocator the block is allocated with and the object is constructed by.
+ * @tparam Policy The reference counting policy.
+ */
+template<typename T, typename Alloc, typename Policy>
+class MyInplaceControlBlock : public MySharedControlBlock<Policy> {
+public:
+  /**
+   * @brief Constructs the managed object in place from the given arguments.
+   */
+  template<typename... Args>
+  explicit MyInplaceControlBlock(const Alloc& alloc, Args&&... args) : alloc_(alloc) {
+    ObjectAlloc object_alloc(alloc_);
+    std::allocator_traits<ObjectAlloc>::construct(object_alloc, get(), std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Retrieves a pointer to the inline object.
+   */
+  T* get() {
+    return std::launder(reinterpret_cast<T*>(storage_));
+  }
+
+protected:
+  void dispose() noexcept override {
+    ObjectAlloc object_alloc(alloc_);
+    std::allocator_traits<ObjectAlloc>::destroy(object_alloc, get());
+  }
+
+  void destroy() noexcept override {
+    MyDeallocateControlBlock(this, alloc_);
+  }
+
+private:
+  using ObjectAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<std::remove_cv_t<T>>;
+
+  [[no_unique_address]] Alloc alloc_;            ///< Allocator that owns this block's memory.
+  alignas(T) unsigned char storage_[sizeof(T)];  ///< Raw storage for the managed object.
+};
+
+template<typename T, typename Policy = MultiThreaded>
+class MySharedPtr;
+
+template<typename T, typename Policy = MultiThreaded>
+class MyWeakPtr;
+
+template<typename T>
+class MyAtomicSharedPtr;
+
+template<typename T, typename Policy = MultiThreaded>
+class MyEnableSharedFromThis;
+
+template<typename T, typename Policy = MultiThreaded, typename... Args>
+MySharedPtr<T, Policy> MakeMyShared(Args&&... args);
+
+template<typename T, typename Policy = MultiThreaded, typename Alloc, typename... Args>
+MySharedPtr<T, Policy> AllocateMyShared(const Alloc& alloc, Args&&... args);
 
 /**
  * @brief A custom shared pointer implementation that manages shared ownership of a dynamically allocated object.
  *
  * MySharedPtr is a simple implementation of a shared pointer, which manages a reference count and cleans up the
- * managed object when the count reaches zero. It supports copy semantics and thread-safe reference counting.
+ * managed object when the count reaches zero. It supports copy and move semantics and lock-free, thread-safe
+ * reference counting. Moves transfer ownership without touching the reference count.
+ * The count lives in a control block; a null MySharedPtr has no control block and allocates nothing.
+ *
+ * The Policy chooses how the count is maintained. The default, MultiThreaded, lets copies of one
+ * MySharedPtr live on different threads. SingleThreaded uses plain integer counts for objects that
+ * never leave the thread that created them.
+ *
+ * The control block is type-erased: a pointer may own its object through a custom deleter and keep
+ * its control block in memory from a custom allocator, and none of that shows up in its type.
+ * Pointers made from a raw pointer or by MakeMyShared pay nothing for this beyond the virtual
+ * calls that already release the object.
+ *
+ * MySharedPtr<T[]> owns an array allocated with `new[]`, releases it with `delete[]` and offers
+ * operator[]. The aliasing constructor lets a pointer to a member or to a slice of an array share
+ * the owner's control block, so handing out parts of one allocation allocates nothing.
  *
- * @tparam T The type of the object managed by this pointer.
+ * @tparam T The type of the object managed by this pointer, or U[] for an array of U.
+ * @tparam Policy The reference counting policy, MultiThreaded or SingleThreaded.
  */
-template<typename T>
+template<typename T, typename Policy>
 class MySharedPtr {
 public:
+  /**
+   * @brief The type of the object pointed to; the element type if T is an array.
+   */
+  using element_type = std::remove_extent_t<T>;
+
+  /**
+   * @brief Two pointers, and nothing points back into it.
+   */
+  using is_trivially_relocatable = std::true_type;
+
   /**
    * @brief Constructs a MySharedPtr.
    *
-   * Initializes a new MySharedPtr to manage the given raw pointer. If the pointer is non-null, 
-   * the reference count is set to 1; otherwise, it is set to 0.
+   * Initializes a new MySharedPtr to manage the given raw pointer. If the pointer is non-null, a control
+   * block is allocated and the reference count is set to 1; otherwise, no control block is allocated and
+   * the reference count is 0. Prefer MakeMyShared, which allocates the object and its control block together.
    *
    * @param ptr Pointer to the object to be managed (can be nullptr).
    */
-  MySharedPtr(T* ptr = nullptr) : ptr_(ptr) {
-    mutex_ = new std::mutex();
-    if (!ptr) {
-      // If ptr is nullptr, initialize count to 0.
-      count_ = new size_t(0);
-    } else {
-      count_ = new size_t(1);
+  MySharedPtr(element_type* ptr = nullptr) : ptr_(ptr), cb_(nullptr) {
+    if (ptr) {
+      try {
+        cb_ = new MyPointerControlBlock<T, Policy>(ptr);
+      } catch (...) {
+        // We own ptr from here on, so it must not leak if the control block cannot be allocated.
+        MyDeleteOwned<T>(ptr);
+        throw;
+      }
+      enable_shared_from_this(ptr);
+    }
+  }
+
+  /**
+   * @brief Constructs a MySharedPtr that releases ptr with a custom deleter.
+   *
+   * A control block is allocated even if ptr is null, so the deleter always runs exactly once,
+   * when the last owner is gone. If the control block cannot be allocated, deleter(ptr) is called
+   * before the exception propagates.
+   *
+   * @tparam Deleter A copyable callable taking an element_type*.
+   * @param ptr Pointer to the object to be managed (can be nullptr).
+   * @param deleter The callable that releases ptr.
+   */
+  template<typename Deleter>
+  MySharedPtr(element_type* ptr, Deleter deleter)
+      : MySharedPtr(ptr, std::move(deleter), std::allocator<element_type>()) {}
+
+  /**
+   * @brief Constructs a MySharedPtr that releases ptr with a custom deleter and allocates its
+   * control block with alloc.
+   *
+   * If the control block cannot be allocated, deleter(ptr) is called before the exception
+   * propagates.
+   *
+   * @tparam Deleter A copyable callable taking an element_type*.
+   * @tparam Alloc An allocator; it is rebound to the control block type.
+   * @param ptr Pointer to the object to be managed (can be nullptr).
+   * @param deleter The callable that releases ptr.
+   * @param alloc The allocator for the control block.
+   */
+  template<typename Deleter, typename Alloc>
+  MySharedPtr(element_type* ptr, Deleter deleter, const Alloc& alloc) : ptr_(ptr), cb_(nullptr) {
+    try {
+      cb_ = MyAllocateControlBlock<MyDeleterControlBlock<element_type, Deleter, Alloc, Policy>>(alloc, ptr, deleter);
+    } catch (...) {
+      deleter(ptr);
+      throw;
     }
+    enable_shared_from_this(ptr);
   }
 
   /**
    * @brief Destroys the MySharedPtr.
    *
    * Decrements the reference count and, if it reaches zero, deletes the managed object
-   * along with the associated reference count and mutex.
+   * along with its control block.
    */
   ~MySharedPtr() {
     sub_count();
@@ -52,11 +509,10 @@ public:
    */
   MySharedPtr(const MySharedPtr& other) {
     ptr_ = other.ptr_;
-    count_ = other.count_;
-    mutex_ = other.mutex_;
+    cb_ = other.cb_;
     add_count();
   }
-  
+
   /**
    * @brief Assignment operator.
    *
@@ -74,12 +530,119 @@ public:
     sub_count();
 
     ptr_ = other.ptr_;
-    count_ = other.count_;
-    mutex_ = other.mutex_;
+    cb_ = other.cb_;
+    add_count();
+    return *this;
+  }
+
+  /**
+   * @brief Converting copy constructor.
+   *
+   * Shares ownership of an object managed through a pointer to a derived type.
+   *
+   * @tparam U A type whose pointer converts implicitly to T*.
+   * @param other The MySharedPtr instance to copy.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  MySharedPtr(const MySharedPtr<U, Policy>& other) : ptr_(other.ptr_), cb_(other.cb_) {
+    add_count();
+  }
+
+  /**
+   * @brief Aliasing constructor.
+   *
+   * Shares ownership with owner but points at ptr, typically a member or an element of the object
+   * owner manages. The owner's object stays alive as long as this pointer does. No allocation takes
+   * place; the owner's reference count goes up by one.
+   *
+   * @param owner The MySharedPtr whose ownership is shared.
+   * @param ptr The pointer this instance returns from get(); not owned on its own.
+   */
+  template<typename U>
+  MySharedPtr(const MySharedPtr<U, Policy>& owner, element_type* ptr) noexcept : ptr_(ptr), cb_(owner.cb_) {
     add_count();
+  }
+
+  /**
+   * @brief Aliasing move constructor.
+   *
+   * Like the aliasing constructor, but takes over owner's reference instead of adding one, leaving
+   * owner null.
+   *
+   * @param owner The MySharedPtr whose ownership is taken over.
+   * @param ptr The pointer this instance returns from get(); not owned on its own.
+   */
+  template<typename U>
+  MySharedPtr(MySharedPtr<U, Policy>&& owner, element_type* ptr) noexcept : ptr_(ptr), cb_(owner.cb_) {
+    owner.ptr_ = nullptr;
+    owner.cb_ = nullptr;
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * Takes over ownership from other without touching the reference count, leaving other null.
+   *
+   * @param other The MySharedPtr instance to move from.
+   */
+  MySharedPtr(MySharedPtr&& other) noexcept : ptr_(other.ptr_), cb_(other.cb_) {
+    other.ptr_ = nullptr;
+    other.cb_ = nullptr;
+  }
+
+  /**
+   * @brief Converting move constructor.
+   *
+   * Takes over ownership of an object managed through a pointer to a derived type, without
+   * touching the reference count, leaving other null.
+   *
+   * @tparam U A type whose pointer converts implicitly to T*.
+   * @param other The MySharedPtr instance to move from.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  MySharedPtr(MySharedPtr<U, Policy>&& other) noexcept : ptr_(other.ptr_), cb_(other.cb_) {
+    other.ptr_ = nullptr;
+    other.cb_ = nullptr;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * Releases the currently managed object and takes over ownership from other, leaving other null.
+   *
+   * @param other The MySharedPtr instance to move from.
+   * @return A reference to the updated MySharedPtr.
+   */
+  MySharedPtr& operator=(MySharedPtr&& other) noexcept {
+    MySharedPtr(std::move(other)).swap(*this);
     return *this;
   }
 
+  /**
+   * @brief Converting move assignment operator.
+   *
+   * @tparam U A type whose pointer converts implicitly to T*.
+   * @param other The MySharedPtr instance to move from.
+   * @return A reference to the updated MySharedPtr.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  MySharedPtr& operator=(MySharedPtr<U, Policy>&& other) noexcept {
+    MySharedPtr(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  /**
+   * @brief Exchanges the managed objects of two MySharedPtr instances.
+   *
+   * Neither reference count changes.
+   *
+   * @param other The MySharedPtr instance to swap with.
+   */
+  void swap(MySharedPtr& other) noexcept {
+    std::swap(ptr_, other.ptr_);
+    std::swap(cb_, other.cb_);
+  }
+
   /**
    * @brief Dereference operator.
    *
@@ -87,10 +650,10 @@ public:
    *
    * @return A reference to the managed object.
    */
-  T& operator*() {
+  element_type& operator*() {
     return *ptr_;
   }
-  
+
   /**
    * @brief Member access operator.
    *
@@ -98,10 +661,21 @@ public:
    *
    * @return A pointer to the managed object.
    */
-  T* operator->() {
+  element_type* operator->() {
     return ptr_;
   }
-  
+
+  /**
+   * @brief Array subscript operator. Only available when T is an array type.
+   *
+   * @param index The position of the element; not bounds-checked.
+   * @return A reference to the element at index.
+   */
+  element_type& operator[](std::ptrdiff_t index) const {
+    static_assert(std::is_array_v<T>, "operator[] requires MySharedPtr<T[]>");
+    return ptr_[index];
+  }
+
   /**
    * @brief Retrieves the current number of shared owners.
    *
@@ -111,8 +685,7 @@ public:
    * @return The number of shared owners.
    */
   size_t use_count() const {
-    std::lock_guard<std::mutex> lock(*mutex_);
-    return *count_;
+    return cb_ ? cb_->use_count() : 0;
   }
 
   /**
@@ -120,7 +693,7 @@ public:
    *
    * @return A pointer to the managed object.
    */
-  T* get() const {
+  element_type* get() const {
     return ptr_;
   }
 
@@ -131,9 +704,52 @@ public:
    */
   explicit operator bool() const noexcept {
     return ptr_ != nullptr;
-  } 
+  }
 
 private:
+  template<typename U, typename P>
+  friend class MySharedPtr;
+
+  template<typename U, typename P>
+  friend class MyWeakPtr;
+
+  template<typename U>
+  friend class MyAtomicSharedPtr;
+
+  template<typename U, typename P, typename A, typename... Args>
+  friend MySharedPtr<U, P> AllocateMyShared(const A& alloc, Args&&... args);
+
+  /**
+   * @brief Selects the adopting constructor, which would otherwise look like the deleter one.
+   */
+  struct AdoptTag {};
+
+  /**
+   * @brief Adopts an object whose control block has already been created.
+   *
+   * @param ptr Pointer to the managed object.
+   * @param cb The control block owning ptr, with its count already accounting for this instance.
+   */
+  MySharedPtr(AdoptTag, element_type* ptr, MySharedControlBlock<Policy>* cb) : ptr_(ptr), cb_(cb) {}
+
+  /**
+   * @brief Points the MyEnableSharedFromThis base of a newly owned object at this instance's
+   * control block, unless the object is already owned.
+   *
+   * Chosen by overload resolution when element_type derives from MyEnableSharedFromThis with the
+   * same Policy; for every other type the no-op overload below is picked instead.
+   */
+  template<typename U>
+  void enable_shared_from_this(const MyEnableSharedFromThis<U, Policy>* base) noexcept {
+    if constexpr (!std::is_array_v<T>) {
+      if (base != nullptr && base->weak_this_.expired()) {
+        base->weak_this_ = MyWeakPtr<U, Policy>(*this);
+      }
+    }
+  }
+
+  void enable_shared_from_this(...) noexcept {}
+
   /**
    * @brief Increments the reference count.
    *
@@ -141,37 +757,349 @@ private:
    * that there is an additional owner.
    */
   void add_count() {
-    std::lock_guard<std::mutex> lock(*mutex_);
-    (*count_)++;
+    if (cb_) {
+      cb_->add_ref();
+    }
   }
 
   /**
    * @brief Decrements the reference count and deletes the managed object if no owners remain.
-   *
-   * Safely decrements the reference count under a lock. If the count drops to zero, the managed
-   * object and the reference count are deleted, and the mutex is deallocated after the lock is released.
    */
   void sub_count() {
-    bool should_delete_mutex{false};
-    {
-      std::lock_guard<std::mutex> lock(*mutex_);
-      (*count_)--;
-      if (*count_ == 0) {
-        // When count_ reaches 0, no MySharedPtr instances are sharing this object,
-        // so delete the managed object and the reference count.
-        delete ptr_;
-        delete count_;
-        // The mutex cannot be deleted directly while within the lock_guard scope;
-        // mark it for deletion after leaving the scope.
-        should_delete_mutex = true;
-      }
+    if (cb_) {
+      cb_->release();
     }
-    if (should_delete_mutex) {
-      delete mutex_;
+  }
+
+  element_type* ptr_;                 ///< Pointer to the managed object.
+  MySharedControlBlock<Policy>* cb_;  ///< Pointer to the control block, or nullptr if nothing is owned.
+};
+
+/**
+ * @brief Creates an object and the MySharedPtr that owns it with a single allocation.
+ *
+ * The object is constructed inside its control block, so there is one heap allocation instead
+ * of one for the object plus one for the control block.
+ *
+ * @tparam T The type of the object to create.
+ * @tparam Policy The reference counting policy of the returned pointer.
+ * @param args Arguments forwarded to the constructor of T.
+ * @return A MySharedPtr owning the new object, with a reference count of 1.
+ */
+template<typename T, typename Policy, typename... Args>
+MySharedPtr<T, Policy> MakeMyShared(Args&&... args) {
+  return AllocateMyShared<T, Policy>(std::allocator<T>(), std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Like MakeMyShared, but takes the single allocation from alloc.
+ *
+ * The object is constructed and destroyed through the allocator, and the block's memory goes back
+ * to it once the last MySharedPtr and MyWeakPtr are gone. A stateless allocator adds nothing to the
+ * size of the block.
+ *
+ * @tparam T The type of the object to create.
+ * @tparam Policy The reference counting policy of the returned pointer.
+ * @tparam Alloc An allocator; it is rebound to the control block type.
+ * @param alloc The allocator that provides the memory.
+ * @param args Arguments forwarded to the constructor of T.
+ * @return A MySharedPtr owning the new object, with a reference count of 1.
+ */
+template<typename T, typename Policy, typename Alloc, typename... Args>
+MySharedPtr<T, Policy> AllocateMyShared(const Alloc& alloc, Args&&... args) {
+  auto* cb = MyAllocateControlBlock<MyInplaceControlBlock<T, Alloc, Policy>>(alloc, std::forward<Args>(args)...);
+  MySharedPtr<T, Policy> result(typename MySharedPtr<T, Policy>::AdoptTag(), cb->get(), cb);
+  result.enable_shared_from_this(result.ptr_);
+  return result;
+}
+
+/**
+ * @brief Exchanges the managed objects of two MySharedPtr instances.
+ *
+ * Found by argument-dependent lookup, so `using std::swap; swap(a, b);` does not touch the counts.
+ */
+template<typename T, typename Policy>
+void swap(MySharedPtr<T, Policy>& lhs, MySharedPtr<T, Policy>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+/**
+ * @brief Whether Base is a virtual base of Derived, so that converting a Derived* to a Base*
+ * reads the object to find the base's offset. Found by checking that the downcast, which is
+ * ill-formed only through a virtual base, cannot be written.
+ */
+template<typename Base, typename Derived, typename = void>
+struct MyIsVirtualBaseOf : std::is_base_of<Base, Derived> {};
+
+template<typename Base, typename Derived>
+struct MyIsVirtualBaseOf<Base, Derived, std::void_t<decltype(static_cast<Derived*>(std::declval<Base*>()))>>
+    : std::false_type {};
+
+/**
+ * @brief A non-owning reference to an object managed by MySharedPtr.
+ *
+ * MyWeakPtr observes an object without keeping it alive: the object is destroyed when its last
+ * MySharedPtr goes away, even if MyWeakPtr instances remain. Only the control block stays allocated
+ * until the last MyWeakPtr is gone. Use lock() to obtain a MySharedPtr if the object still exists.
+ *
+ * @tparam T The type of the observed object.
+ * @tparam Policy The reference counting policy, which must match that of the MySharedPtr observed.
+ */
+template<typename T, typename Policy>
+class MyWeakPtr {
+public:
+  /**
+   * @brief Two pointers, like MySharedPtr.
+   */
+  using is_trivially_relocatable = std::true_type;
+
+  /**
+   * @brief Constructs an empty MyWeakPtr that observes nothing.
+   */
+  MyWeakPtr() noexcept : ptr_(nullptr), cb_(nullptr) {}
+
+  /**
+   * @brief Constructs a MyWeakPtr observing the object owned by a MySharedPtr.
+   *
+   * @tparam U A type whose pointer converts implicitly to T*.
+   * @param shared The MySharedPtr whose object to observe.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  MyWeakPtr(const MySharedPtr<U, Policy>& shared) noexcept : ptr_(shared.ptr_), cb_(shared.cb_) {
+    add_weak_count();
+  }
+
+  /**
+   * @brief Copy constructor.
+   *
+   * @param other The MyWeakPtr instance to copy.
+   */
+  MyWeakPtr(const MyWeakPtr& other) noexcept : ptr_(other.ptr_), cb_(other.cb_) {
+    add_weak_count();
+  }
+
+  /**
+   * @brief Converting copy constructor.
+   *
+   * The observed object may already be destroyed, so when T is a virtual base of U, whose
+   * offset is read from the object, the pointer is converted through lock(). An expired
+   * object then leaves a null pointer alongside the control block.
+   *
+   * @tparam U A type whose pointer converts implicitly to T*.
+   * @param other The MyWeakPtr instance to copy.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  MyWeakPtr(const MyWeakPtr<U, Policy>& other) noexcept : ptr_(nullptr), cb_(other.cb_) {
+    if constexpr (MyIsVirtualBaseOf<std::remove_cv_t<T>, std::remove_cv_t<U>>::value) {
+      ptr_ = other.lock().get();
+    } else {
+      ptr_ = other.ptr_;
+    }
+    add_weak_count();
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * Takes over other's observation without touching the weak count, leaving other empty.
+   *
+   * @param other The MyWeakPtr instance to move from.
+   */
+  MyWeakPtr(MyWeakPtr&& other) noexcept : ptr_(other.ptr_), cb_(other.cb_) {
+    other.ptr_ = nullptr;
+    other.cb_ = nullptr;
+  }
+
+  /**
+   * @brief Destroys the MyWeakPtr, freeing the control block if it was the last reference to it.
+   */
+  ~MyWeakPtr() {
+    sub_weak_count();
+  }
+
+  /**
+   * @brief Copy assignment operator.
+   *
+   * @param other The MyWeakPtr instance to copy.
+   * @return A reference to the updated MyWeakPtr.
+   */
+  MyWeakPtr& operator=(const MyWeakPtr& other) noexcept {
+    MyWeakPtr(other).swap(*this);
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param other The MyWeakPtr instance to move from.
+   * @return A reference to the updated MyWeakPtr.
+   */
+  MyWeakPtr& operator=(MyWeakPtr&& other) noexcept {
+    MyWeakPtr(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  /**
+   * @brief Starts observing the object owned by a MySharedPtr.
+   *
+   * @param shared The MySharedPtr whose object to observe.
+   * @return A reference to the updated MyWeakPtr.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  MyWeakPtr& operator=(const MySharedPtr<U, Policy>& shared) noexcept {
+    MyWeakPtr(shared).swap(*this);
+    return *this;
+  }
+
+  /**
+   * @brief Obtains shared ownership of the observed object if it still exists.
+   *
+   * Safe to call concurrently with the last owner releasing the object: either the object is
+   * kept alive by the returned pointer, or the returned pointer is null.
+   *
+   * @return A MySharedPtr owning the object, or a null MySharedPtr if it has been destroyed.
+   */
+  MySharedPtr<T, Policy> lock() const noexcept {
+    if (cb_ && cb_->try_add_ref()) {
+      return MySharedPtr<T, Policy>(typename MySharedPtr<T, Policy>::AdoptTag(), ptr_, cb_);
+    }
+    return MySharedPtr<T, Policy>();
+  }
+
+  /**
+   * @brief Checks whether the observed object has been destroyed.
+   *
+   * @return true if there is no object to observe any more, false otherwise.
+   */
+  bool expired() const noexcept {
+    return use_count() == 0;
+  }
+
+  /**
+   * @brief Retrieves the number of MySharedPtr instances that own the observed object.
+   *
+   * @return The strong count, or 0 if the MyWeakPtr is empty.
+   */
+  size_t use_count() const noexcept {
+    return cb_ ? cb_->use_count() : 0;
+  }
+
+  /**
+   * @brief Stops observing the object, leaving this MyWeakPtr empty.
+   */
+  void reset() noexcept {
+    MyWeakPtr().swap(*this);
+  }
+
+  /**
+   * @brief Exchanges the observed objects of two MyWeakPtr instances.
+   *
+   * @param other The MyWeakPtr instance to swap with.
+   */
+  void swap(MyWeakPtr& other) noexcept {
+    std::swap(ptr_, other.ptr_);
+    std::swap(cb_, other.cb_);
+  }
+
+private:
+  template<typename U, typename P>
+  friend class MyWeakPtr;
+
+  /**
+   * @brief Increments the weak count of the observed object's control block, if any.
+   */
+  void add_weak_count() noexcept {
+    if (cb_) {
+      cb_->add_weak();
+    }
+  }
+
+  /**
+   * @brief Decrements the weak count of the observed object's control block, if any.
+   */
+  void sub_weak_count() noexcept {
+    if (cb_) {
+      cb_->release_weak();
+    }
+  }
+
+  std::remove_extent_t<T>* ptr_;  ///< Pointer to the observed object; only dereferenced through lock().
+  MySharedControlBlock<Policy>* cb_;  ///< Pointer to the control block, or nullptr if nothing is observed.
+};
+
+/**
+ * @brief A base class that lets an object managed by MySharedPtr hand out owners of itself.
+ *
+ * Derive T from MyEnableSharedFromThis<T, Policy>. When a MySharedPtr<T, Policy> takes ownership
+ * of the object, whether from a raw pointer, with a custom deleter or through MakeMyShared, it
+ * records its control block in the base. shared_from_this() and weak_from_this() then share that
+ * control block: unlike MySharedPtr(this), they create no second owner and allocate nothing.
+ *
+ * @tparam T The class deriving from MyEnableSharedFromThis.
+ * @tparam Policy The reference counting policy of the MySharedPtr that will own the object.
+ */
+template<typename T, typename Policy>
+class MyEnableSharedFromThis {
+public:
+  /**
+   * @brief Retrieves a MySharedPtr that shares ownership of this object.
+   *
+   * @throws std::bad_weak_ptr If the object is not owned by a MySharedPtr.
+   */
+  MySharedPtr<T, Policy> shared_from_this() {
+    return locked();
+  }
+
+  /**
+   * @brief Retrieves a MySharedPtr that shares ownership of this object.
+   *
+   * @throws std::bad_weak_ptr If the object is not owned by a MySharedPtr.
+   */
+  MySharedPtr<const T, Policy> shared_from_this() const {
+    return locked();
+  }
+
+  /**
+   * @brief Retrieves a MyWeakPtr to this object.
+   *
+   * @return A MyWeakPtr observing this object, or an empty one if no MySharedPtr owns it.
+   */
+  MyWeakPtr<T, Policy> weak_from_this() noexcept {
+    return weak_this_;
+  }
+
+  /**
+   * @brief Retrieves a MyWeakPtr to this object.
+   *
+   * @return A MyWeakPtr observing this object, or an empty one if no MySharedPtr owns it.
+   */
+  MyWeakPtr<const T, Policy> weak_from_this() const noexcept {
+    return weak_this_;
+  }
+
+protected:
+  MyEnableSharedFromThis() noexcept = default;
+
+  // A copy is a different object, owned by whoever owns it, if anyone.
+  MyEnableSharedFromThis(const MyEnableSharedFromThis&) noexcept {}
+
+  MyEnableSharedFromThis& operator=(const MyEnableSharedFromThis&) noexcept {
+    return *this;
+  }
+
+  ~MyEnableSharedFromThis() = default;
+
+private:
+  template<typename U, typename P>
+  friend class MySharedPtr;
+
+  MySharedPtr<T, Policy> locked() const {
+    MySharedPtr<T, Policy> shared = weak_this_.lock();
+    if (!shared) {
+      throw std::bad_weak_ptr();
     }
+    return shared;
   }
 
-  T* ptr_;               ///< Pointer to the managed object.
-  size_t* count_;        ///< Pointer to the reference count.
-  std::mutex* mutex_;    ///< Pointer to the mutex used for thread-safe operations.
-};
\ No newline at end of file
+  mutable MyWeakPtr<T, Policy> weak_this_;  ///< Observes the object once a MySharedPtr owns it.
+};
@@ -42,4 +42,13 @@ int main() {
 
   MySharedPtr<Object> ptr3(ptr1);
   std::cout << "ptr3 use_count: " << ptr3.use_count() << std::endl;
+
+  // The object and its control block come from a single allocation.
+  MySharedPtr<Object> ptr4 = MakeMyShared<Object>();
+  std::cout << "ptr4 use_count: " << ptr4.use_count() << std::endl;
+
+  // A weak pointer observes the object without keeping it alive.
+  MyWeakPtr<Object> weak(ptr4);
+  ptr4 = MySharedPtr<Object>();
+  std::cout << "weak expired: " << std::boolalpha << weak.expired() << std::endl;
 } 
\ No newline at end of file
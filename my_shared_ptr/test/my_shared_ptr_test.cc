@@ -1,6 +1,11 @@
+#include <atomic>
+#include <cstdint>
 #include <thread>
 #include <vector>
 #include <gtest/gtest.h>
+#include "my_atomic_shared_ptr.h"
+#include "my_biased_ref_count.h"
+#include "my_deferred.h"
 #include "my_shared_ptr.h"
 
 TEST(MySharedPtrTest, NullPointer) {
@@ -117,3 +122,755 @@ TEST(MySharedPtrTest, ObjectDestruction) {
   EXPECT_EQ(TestObject::instances, 0);
 }
 
+TEST(MySharedPtrTest, CopyOfNullPointer) {
+  MySharedPtr<int> sp;
+  {
+    MySharedPtr<int> sp2(sp);
+    EXPECT_EQ(sp2.use_count(), 0);
+    EXPECT_FALSE(sp2);
+  }
+  EXPECT_EQ(sp.use_count(), 0);
+}
+
+// A type with constructor arguments and an alignment stricter than the control block's header.
+struct alignas(32) AlignedPoint {
+  AlignedPoint(int x, int y) : x(x), y(y) {}
+  int x;
+  int y;
+};
+
+TEST(MySharedPtrTest, MakeMyShared) {
+  MySharedPtr<AlignedPoint> sp = MakeMyShared<AlignedPoint>(3, 4);
+  ASSERT_TRUE(sp);
+  EXPECT_EQ(sp.use_count(), 1);
+  EXPECT_EQ(sp->x, 3);
+  EXPECT_EQ(sp->y, 4);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(sp.get()) % alignof(AlignedPoint), 0);
+
+  MySharedPtr<AlignedPoint> sp2(sp);
+  EXPECT_EQ(sp.use_count(), 2);
+  EXPECT_EQ(sp2.get(), sp.get());
+}
+
+TEST(MySharedPtrTest, MakeMySharedObjectDestruction) {
+  {
+    MySharedPtr<TestObject> sp = MakeMyShared<TestObject>();
+    EXPECT_EQ(TestObject::instances, 1);
+    MySharedPtr<TestObject> sp2;
+    sp2 = sp;
+    EXPECT_EQ(sp2.use_count(), 2);
+    sp = MySharedPtr<TestObject>();
+    EXPECT_EQ(sp2.use_count(), 1);
+    EXPECT_EQ(TestObject::instances, 1);
+  }
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MySharedPtrTest, MoveConstructor) {
+  MySharedPtr<int> sp = MakeMyShared<int>(7);
+  int* raw = sp.get();
+  MySharedPtr<int> sp2(std::move(sp));
+  EXPECT_EQ(sp.get(), nullptr);
+  EXPECT_EQ(sp.use_count(), 0);
+  EXPECT_EQ(sp2.get(), raw);
+  EXPECT_EQ(sp2.use_count(), 1);
+}
+
+TEST(MySharedPtrTest, MoveAssignment) {
+  MySharedPtr<TestObject> sp(new TestObject());
+  MySharedPtr<TestObject> sp2(new TestObject());
+  EXPECT_EQ(TestObject::instances, 2);
+
+  // The object previously owned by sp2 is released.
+  sp2 = std::move(sp);
+  EXPECT_EQ(TestObject::instances, 1);
+  EXPECT_FALSE(sp);
+  EXPECT_EQ(sp2.use_count(), 1);
+
+  sp2 = MySharedPtr<TestObject>();
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MySharedPtrTest, Swap) {
+  MySharedPtr<int> sp(new int(1));
+  MySharedPtr<int> sp2(sp);
+  MySharedPtr<int> sp3(new int(2));
+  sp.swap(sp3);
+  EXPECT_EQ(*sp, 2);
+  EXPECT_EQ(*sp3, 1);
+  EXPECT_EQ(sp.use_count(), 1);
+  EXPECT_EQ(sp3.use_count(), 2);
+
+  using std::swap;
+  swap(sp, sp3);
+  EXPECT_EQ(*sp, 1);
+  EXPECT_EQ(*sp3, 2);
+}
+
+class Base {
+ public:
+  virtual ~Base() = default;
+  virtual int value() const { return 1; }
+};
+
+class Derived : public Base {
+ public:
+  int value() const override { return 2; }
+};
+
+TEST(MySharedPtrTest, ConvertingCopyAndMove) {
+  MySharedPtr<Derived> derived = MakeMyShared<Derived>();
+  MySharedPtr<Base> base(derived);
+  EXPECT_EQ(base->value(), 2);
+  EXPECT_EQ(derived.use_count(), 2);
+
+  MySharedPtr<Base> moved(std::move(derived));
+  EXPECT_FALSE(derived);
+  EXPECT_EQ(moved.use_count(), 2);
+
+  MySharedPtr<Base> assigned;
+  assigned = MakeMyShared<Derived>();
+  EXPECT_EQ(assigned->value(), 2);
+  EXPECT_EQ(assigned.use_count(), 1);
+}
+
+// A thread-safe policy that also counts every update of a reference count, so that tests can
+// check that an operation does not touch the counts at all.
+struct CountingPolicy {
+  using Count = MultiThreaded::Count;
+
+  static void increment(Count& count) noexcept {
+    ++ops;
+    MultiThreaded::increment(count);
+  }
+
+  static bool increment_if_nonzero(Count& count) noexcept {
+    ++ops;
+    return MultiThreaded::increment_if_nonzero(count);
+  }
+
+  static bool decrement(Count& count) noexcept {
+    ++ops;
+    return MultiThreaded::decrement(count);
+  }
+
+  static size_t load(const Count& count) noexcept {
+    return MultiThreaded::load(count);
+  }
+
+  static inline std::atomic<size_t> ops{0};
+};
+
+TEST(MySharedPtrTest, VectorGrowDoesNotTouchCounts) {
+  MySharedPtr<int, CountingPolicy> sp(new int(42));
+  std::vector<MySharedPtr<int, CountingPolicy>> copies(16, sp);
+  EXPECT_EQ(sp.use_count(), 17);
+
+  // Growing the vector relocates every element; with a noexcept move that must not change any count.
+  size_t ops_before = CountingPolicy::ops.load();
+  copies.reserve(copies.capacity() * 4);
+  std::vector<MySharedPtr<int, CountingPolicy>> moved(std::move(copies));
+  std::swap(moved[0], moved[1]);
+  EXPECT_EQ(CountingPolicy::ops.load(), ops_before);
+  EXPECT_EQ(sp.use_count(), 17);
+}
+
+TEST(MySharedPtrTest, MovesAndSwapsDoNotTouchCounts) {
+  MySharedPtr<Derived, CountingPolicy> derived = MakeMyShared<Derived, CountingPolicy>();
+  MySharedPtr<Derived, CountingPolicy> other = MakeMyShared<Derived, CountingPolicy>();
+  size_t ops_before = CountingPolicy::ops.load();
+
+  MySharedPtr<Derived, CountingPolicy> moved(std::move(derived));
+  derived = std::move(moved);
+  derived.swap(other);
+  using std::swap;
+  swap(derived, other);
+  MySharedPtr<Base, CountingPolicy> base(std::move(derived));
+  EXPECT_EQ(CountingPolicy::ops.load(), ops_before);
+  EXPECT_EQ(base.use_count(), 1);
+  EXPECT_EQ(other.use_count(), 1);
+  EXPECT_FALSE(derived);
+  EXPECT_FALSE(moved);
+}
+
+TEST(MyWeakPtrTest, EmptyWeakPointer) {
+  MyWeakPtr<int> wp;
+  EXPECT_TRUE(wp.expired());
+  EXPECT_EQ(wp.use_count(), 0);
+  EXPECT_FALSE(wp.lock());
+
+  MyWeakPtr<int> from_null{MySharedPtr<int>()};
+  EXPECT_TRUE(from_null.expired());
+}
+
+TEST(MyWeakPtrTest, LockWhileAlive) {
+  MySharedPtr<int> sp = MakeMyShared<int>(5);
+  MyWeakPtr<int> wp(sp);
+  EXPECT_FALSE(wp.expired());
+  EXPECT_EQ(wp.use_count(), 1);
+
+  MySharedPtr<int> locked = wp.lock();
+  ASSERT_TRUE(locked);
+  EXPECT_EQ(*locked, 5);
+  EXPECT_EQ(sp.use_count(), 2);
+}
+
+TEST(MyWeakPtrTest, DoesNotKeepObjectAlive) {
+  MyWeakPtr<TestObject> wp;
+  {
+    MySharedPtr<TestObject> sp = MakeMyShared<TestObject>();
+    wp = sp;
+    MyWeakPtr<TestObject> wp2(wp);
+    EXPECT_EQ(wp2.use_count(), 1);
+    EXPECT_EQ(TestObject::instances, 1);
+  }
+  // The object is gone as soon as its last owner is, even though wp still refers to the block.
+  EXPECT_EQ(TestObject::instances, 0);
+  EXPECT_TRUE(wp.expired());
+  EXPECT_FALSE(wp.lock());
+  wp.reset();
+  EXPECT_TRUE(wp.expired());
+}
+
+TEST(MyWeakPtrTest, CopyMoveAndConversion) {
+  MySharedPtr<Derived> derived(new Derived());
+  MyWeakPtr<Base> wp(derived);
+  MyWeakPtr<Base> copy(wp);
+  MyWeakPtr<Base> moved(std::move(copy));
+  EXPECT_TRUE(copy.expired());
+  ASSERT_FALSE(moved.expired());
+  EXPECT_EQ(moved.lock()->value(), 2);
+
+  derived = MySharedPtr<Derived>();
+  EXPECT_TRUE(wp.expired());
+  EXPECT_TRUE(moved.expired());
+}
+
+class VirtualDerived : public virtual Base {
+ public:
+  int value() const override { return 3; }
+};
+
+TEST(MyWeakPtrTest, ConvertsToAVirtualBaseWithoutTouchingTheObject) {
+  MySharedPtr<VirtualDerived> owner(new VirtualDerived());
+  MyWeakPtr<VirtualDerived> wp(owner);
+  MyWeakPtr<Base> alive(wp);
+  EXPECT_EQ(alive.lock()->value(), 3);
+
+  // The object is freed, so finding the Base inside it would read freed memory.
+  owner = MySharedPtr<VirtualDerived>();
+  MyWeakPtr<Base> expired(wp);
+  EXPECT_TRUE(expired.expired());
+  EXPECT_FALSE(expired.lock());
+  static_assert(MyIsVirtualBaseOf<Base, VirtualDerived>::value);
+  static_assert(!MyIsVirtualBaseOf<Base, Derived>::value);
+}
+
+TEST(MyWeakPtrTest, LockRacesWithLastRelease) {
+  const int rounds = 200;
+  const int num_threads = 4;
+  for (int round = 0; round < rounds; ++round) {
+    MySharedPtr<TestObject> sp = MakeMyShared<TestObject>();
+    MyWeakPtr<TestObject> wp(sp);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(std::thread([wp]() {
+        // Either the object is still there and stays alive while we hold it, or lock() fails.
+        for (int j = 0; j < 100; ++j) {
+          MySharedPtr<TestObject> locked = wp.lock();
+          if (locked) {
+            EXPECT_GE(TestObject::instances, 1);
+          }
+        }
+      }));
+    }
+    sp = MySharedPtr<TestObject>();
+    for (auto& t : threads) {
+      t.join();
+    }
+    EXPECT_TRUE(wp.expired());
+    EXPECT_EQ(TestObject::instances, 0);
+  }
+}
+
+TEST(MyAtomicSharedPtrTest, LoadAndStore) {
+  MyAtomicSharedPtr<int> slot;
+  EXPECT_TRUE(slot.is_lock_free());
+  EXPECT_FALSE(slot.load());
+
+  MySharedPtr<int> value = MakeMyShared<int>(1);
+  slot.store(value);
+  EXPECT_EQ(value.use_count(), 2);
+  MySharedPtr<int> loaded = slot.load();
+  EXPECT_EQ(loaded.get(), value.get());
+  EXPECT_EQ(value.use_count(), 3);
+
+  slot.store(MySharedPtr<int>());
+  EXPECT_FALSE(slot.load());
+  EXPECT_EQ(value.use_count(), 2);
+}
+
+TEST(MyAtomicSharedPtrTest, Exchange) {
+  MyAtomicSharedPtr<int> slot(MakeMyShared<int>(1));
+  MySharedPtr<int> previous = slot.exchange(MakeMyShared<int>(2));
+  EXPECT_EQ(*previous, 1);
+  EXPECT_EQ(previous.use_count(), 1);
+  EXPECT_EQ(*slot.load(), 2);
+}
+
+TEST(MyAtomicSharedPtrTest, CompareExchange) {
+  MySharedPtr<int> first = MakeMyShared<int>(1);
+  MyAtomicSharedPtr<int> slot(first);
+
+  // An equal value in a different control block does not match.
+  MySharedPtr<int> expected = MakeMyShared<int>(1);
+  EXPECT_FALSE(slot.compare_exchange_strong(expected, MakeMyShared<int>(2)));
+  EXPECT_EQ(expected.get(), first.get());
+
+  EXPECT_TRUE(slot.compare_exchange_strong(expected, MakeMyShared<int>(3)));
+  EXPECT_EQ(*slot.load(), 3);
+  EXPECT_EQ(first.use_count(), 2);  // first and expected
+
+  MySharedPtr<int> null_expected;
+  EXPECT_FALSE(slot.compare_exchange_weak(null_expected, MySharedPtr<int>()));
+  EXPECT_EQ(*null_expected, 3);
+}
+
+TEST(MyAtomicSharedPtrTest, ReleasesValues) {
+  {
+    MyAtomicSharedPtr<TestObject> slot(MakeMyShared<TestObject>());
+    MySharedPtr<TestObject> held = slot.load();
+    slot.store(MakeMyShared<TestObject>());
+    EXPECT_EQ(TestObject::instances, 2);
+    held = MySharedPtr<TestObject>();
+    EXPECT_EQ(TestObject::instances, 1);
+  }
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MyAtomicSharedPtrTest, ConcurrentReadersAndWriters) {
+  struct Snapshot {
+    explicit Snapshot(int v) : value(v), check(-v) {}
+    int value;
+    int check;
+  };
+  MyAtomicSharedPtr<Snapshot> slot(MakeMyShared<Snapshot>(0));
+  const int num_writers = 2;
+  const int num_readers = 4;
+  const int iterations = 2000;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_writers; ++i) {
+    threads.push_back(std::thread([&slot, iterations]() {
+      // Increment the published value with a compare-exchange loop.
+      for (int j = 0; j < iterations; ++j) {
+        MySharedPtr<Snapshot> current = slot.load();
+        while (!slot.compare_exchange_weak(current, MakeMyShared<Snapshot>(current->value + 1))) {
+        }
+      }
+    }));
+  }
+  for (int i = 0; i < num_readers; ++i) {
+    threads.push_back(std::thread([&slot, iterations]() {
+      int last = 0;
+      for (int j = 0; j < iterations; ++j) {
+        MySharedPtr<Snapshot> snapshot = slot.load();
+        ASSERT_TRUE(snapshot);
+        EXPECT_EQ(snapshot->check, -snapshot->value);
+        EXPECT_GE(snapshot->value, last);
+        last = snapshot->value;
+      }
+    }));
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(slot.load()->value, num_writers * iterations);
+  EXPECT_EQ(slot.load().use_count(), 2);
+}
+
+TEST(MySharedPtrTest, SingleThreadedPolicy) {
+  {
+    MySharedPtr<TestObject, SingleThreaded> sp = MakeMyShared<TestObject, SingleThreaded>();
+    MySharedPtr<TestObject, SingleThreaded> sp2(sp);
+    EXPECT_EQ(sp.use_count(), 2);
+    MyWeakPtr<TestObject, SingleThreaded> wp(sp);
+    sp = MySharedPtr<TestObject, SingleThreaded>();
+    EXPECT_EQ(sp2.use_count(), 1);
+    EXPECT_TRUE(wp.lock());
+    sp2 = MySharedPtr<TestObject, SingleThreaded>(new TestObject());
+    EXPECT_TRUE(wp.expired());
+    EXPECT_EQ(TestObject::instances, 1);
+  }
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MySharedPtrTest, PolicyDefaultsToMultiThreaded) {
+  static_assert(std::is_same_v<MySharedPtr<int>, MySharedPtr<int, MultiThreaded>>);
+  static_assert(std::is_same_v<decltype(MakeMyShared<int>(1)), MySharedPtr<int, MultiThreaded>>);
+  static_assert(std::is_same_v<decltype(MakeMyShared<int, SingleThreaded>(1)), MySharedPtr<int, SingleThreaded>>);
+}
+
+// Counts how often it is called; copies share the counter, as deleters stored in a block are copies.
+struct CountingDeleter {
+  void operator()(TestObject* ptr) const {
+    ++*calls;
+    delete ptr;
+  }
+  int* calls;
+};
+
+TEST(MySharedPtrTest, CustomDeleter) {
+  int calls = 0;
+  {
+    MySharedPtr<TestObject> sp(new TestObject(), CountingDeleter{&calls});
+    MySharedPtr<TestObject> sp2(sp);
+    MyWeakPtr<TestObject> wp(sp);
+    sp = MySharedPtr<TestObject>();
+    EXPECT_EQ(calls, 0);
+    sp2 = MySharedPtr<TestObject>();
+    EXPECT_EQ(calls, 1);
+    EXPECT_TRUE(wp.expired());
+  }
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MySharedPtrTest, CustomDeleterRunsForNull) {
+  int calls = 0;
+  {
+    MySharedPtr<TestObject> sp(nullptr, [&calls](TestObject* ptr) {
+      EXPECT_EQ(ptr, nullptr);
+      ++calls;
+    });
+    EXPECT_EQ(sp.use_count(), 1);
+  }
+  EXPECT_EQ(calls, 1);
+}
+
+struct AllocationCounts {
+  int allocations = 0;
+  int deallocations = 0;
+};
+
+// A minimal allocator that counts the allocations and deallocations made through it and its
+// rebound copies.
+template<typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  explicit CountingAllocator(AllocationCounts* c) : counts(c) {}
+  template<typename U>
+  CountingAllocator(const CountingAllocator<U>& other) : counts(other.counts) {}
+
+  T* allocate(size_t n) {
+    ++counts->allocations;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* ptr, size_t n) {
+    ++counts->deallocations;
+    std::allocator<T>().deallocate(ptr, n);
+  }
+
+  template<typename U>
+  bool operator==(const CountingAllocator<U>& other) const { return counts == other.counts; }
+  template<typename U>
+  bool operator!=(const CountingAllocator<U>& other) const { return counts != other.counts; }
+
+  AllocationCounts* counts;
+};
+
+TEST(MySharedPtrTest, AllocateMyShared) {
+  AllocationCounts counts;
+  {
+    MySharedPtr<TestObject> sp = AllocateMyShared<TestObject>(CountingAllocator<TestObject>(&counts));
+    EXPECT_EQ(counts.allocations, 1);
+    EXPECT_EQ(TestObject::instances, 1);
+    MyWeakPtr<TestObject> wp(sp);
+    sp = MySharedPtr<TestObject>();
+    EXPECT_EQ(TestObject::instances, 0);
+    // The weak reference keeps the block, and so the allocation, alive.
+    EXPECT_EQ(counts.deallocations, 0);
+  }
+  EXPECT_EQ(counts.allocations, 1);
+  EXPECT_EQ(counts.deallocations, 1);
+}
+
+TEST(MySharedPtrTest, CustomDeleterAndAllocator) {
+  int calls = 0;
+  AllocationCounts counts;
+  {
+    MySharedPtr<TestObject> sp(new TestObject(), CountingDeleter{&calls}, CountingAllocator<int>(&counts));
+    EXPECT_EQ(counts.allocations, 1);
+    MySharedPtr<TestObject> sp2(sp);
+    EXPECT_EQ(sp.use_count(), 2);
+  }
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(counts.deallocations, 1);
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MySharedPtrTest, StatelessDeleterAndAllocatorTakeNoSpace) {
+  struct Deleter {
+    void operator()(int* ptr) const { delete ptr; }
+  };
+  using Base = MySharedControlBlock<MultiThreaded>;
+  static_assert(sizeof(MyDeleterControlBlock<int, Deleter, std::allocator<int>, MultiThreaded>) ==
+                sizeof(MyPointerControlBlock<int, MultiThreaded>));
+  static_assert(sizeof(MyInplaceControlBlock<int64_t, std::allocator<int64_t>, MultiThreaded>) ==
+                sizeof(Base) + sizeof(int64_t));
+}
+
+struct Decoded {
+  int header{7};
+  std::vector<int> samples{1, 2, 3};
+};
+
+TEST(MySharedPtrTest, AliasingConstructor) {
+  MySharedPtr<Decoded> owner = MakeMyShared<Decoded>();
+  MySharedPtr<int> header(owner, &owner->header);
+  EXPECT_EQ(*header, 7);
+  EXPECT_EQ(owner.use_count(), 2);
+  EXPECT_EQ(header.use_count(), 2);
+
+  MyWeakPtr<Decoded> watcher(owner);
+  owner = MySharedPtr<Decoded>();
+  // The field keeps the whole object alive.
+  EXPECT_FALSE(watcher.expired());
+  EXPECT_EQ(*header, 7);
+
+  MySharedPtr<std::vector<int>> samples(std::move(header), &watcher.lock()->samples);
+  EXPECT_FALSE(header);
+  EXPECT_EQ(samples.use_count(), 1);
+  EXPECT_EQ(samples->size(), 3u);
+  samples = MySharedPtr<std::vector<int>>();
+  EXPECT_TRUE(watcher.expired());
+}
+
+TEST(MySharedPtrTest, ArrayPointer) {
+  {
+    MySharedPtr<TestObject[]> array(new TestObject[4]);
+    EXPECT_EQ(TestObject::instances, 4);
+    MySharedPtr<TestObject[]> copy(array);
+    EXPECT_EQ(&copy[2], &array[2]);
+    EXPECT_EQ(array.use_count(), 2);
+  }
+  // Released with delete[], so every element is destroyed.
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MySharedPtrTest, ArraySlices) {
+  MySharedPtr<int[]> buffer(new int[8]{0, 1, 2, 3, 4, 5, 6, 7});
+  MySharedPtr<int[]> tail(buffer, buffer.get() + 4);
+  EXPECT_EQ(tail[0], 4);
+  EXPECT_EQ(tail[3], 7);
+  tail[1] = 50;
+  EXPECT_EQ(buffer[5], 50);
+  EXPECT_EQ(buffer.use_count(), 2);
+  buffer = MySharedPtr<int[]>();
+  EXPECT_EQ(tail.use_count(), 1);
+  EXPECT_EQ(tail[1], 50);
+}
+
+TEST(MyBiasedTest, OwnerOnly) {
+  {
+    MySharedPtr<TestObject, Biased> sp = MakeMyShared<TestObject, Biased>();
+    MySharedPtr<TestObject, Biased> sp2(sp);
+    MyWeakPtr<TestObject, Biased> wp(sp);
+    EXPECT_EQ(sp.use_count(), 2);
+    sp = MySharedPtr<TestObject, Biased>();
+    EXPECT_TRUE(wp.lock());
+    sp2 = MySharedPtr<TestObject, Biased>();
+    EXPECT_EQ(TestObject::instances, 0);
+    EXPECT_TRUE(wp.expired());
+    EXPECT_FALSE(wp.lock());
+  }
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MyBiasedTest, ReleasedOnAnotherThread) {
+  MySharedPtr<TestObject, Biased> sp(new TestObject());
+  MyWeakPtr<TestObject, Biased> wp(sp);
+  // The only reference moves to another thread and dies there, taking the shared count below
+  // zero; the object survives until the owner merges.
+  std::thread([moved = std::move(sp)]() mutable { moved = MySharedPtr<TestObject, Biased>(); }).join();
+  EXPECT_EQ(TestObject::instances, 1);
+  MyFlushBiasedCounts();
+  EXPECT_EQ(TestObject::instances, 0);
+  EXPECT_TRUE(wp.expired());
+}
+
+TEST(MyBiasedTest, OwnerMergesWhenItsCountDropsToZero) {
+  MySharedPtr<TestObject, Biased> sp = MakeMyShared<TestObject, Biased>();
+  MySharedPtr<TestObject, Biased> copy;
+  std::thread([&] {
+    copy = sp;
+    EXPECT_EQ(copy.use_count(), 2);
+  }).join();
+  sp = MySharedPtr<TestObject, Biased>();
+  EXPECT_EQ(TestObject::instances, 1);
+  EXPECT_EQ(copy.use_count(), 1);
+  std::thread([&] { copy = MySharedPtr<TestObject, Biased>(); }).join();
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MyBiasedTest, OwnerExits) {
+  MySharedPtr<TestObject, Biased> sp;
+  std::thread([&] {
+    sp = MakeMyShared<TestObject, Biased>();
+    MySharedPtr<TestObject, Biased> local(sp);
+  }).join();
+  EXPECT_EQ(sp.use_count(), 1);
+  MySharedPtr<TestObject, Biased> copy(sp);
+  sp = MySharedPtr<TestObject, Biased>();
+  EXPECT_EQ(TestObject::instances, 1);
+  copy = MySharedPtr<TestObject, Biased>();
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MyBiasedTest, ManyThreads) {
+  constexpr int num_threads = 8;
+  constexpr int iterations = 10000;
+  MySharedPtr<TestObject, Biased> sp = MakeMyShared<TestObject, Biased>();
+  MyWeakPtr<TestObject, Biased> wp(sp);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&] {
+      std::vector<MySharedPtr<TestObject, Biased>> copies;
+      for (int i = 0; i < iterations; ++i) {
+        copies.push_back(sp);
+        if (copies.size() == 16) {
+          copies.clear();
+        }
+        MySharedPtr<TestObject, Biased> locked = wp.lock();
+        EXPECT_TRUE(locked);
+      }
+    });
+  }
+  for (int i = 0; i < iterations; ++i) {
+    MySharedPtr<TestObject, Biased> copy(sp);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(sp.use_count(), 1);
+  sp = MySharedPtr<TestObject, Biased>();
+  EXPECT_EQ(TestObject::instances, 0);
+}
+
+TEST(MyBiasedTest, BiasedHandle) {
+  MySharedPtr<TestObject> global = MakeMyShared<TestObject>();
+  std::thread([&] {
+    MySharedPtr<TestObject, Biased> handle = MakeMyBiasedHandle(global);
+    EXPECT_EQ(handle.get(), global.get());
+    EXPECT_EQ(global.use_count(), 2);
+    MySharedPtr<TestObject, Biased> copy(handle);
+    EXPECT_EQ(global.use_count(), 2);
+  }).join();
+  EXPECT_EQ(global.use_count(), 1);
+}
+
+TEST(MyDeferredTest, DestroysInTheBackground) {
+  std::thread::id destroyed_on;
+  struct Recorder {
+    ~Recorder() { *where = std::this_thread::get_id(); }
+    std::thread::id* where;
+  };
+  MySharedPtr<Recorder, Deferred> sp = MakeMyShared<Recorder, Deferred>(Recorder{&destroyed_on});
+  MyWeakPtr<Recorder, Deferred> wp(sp);
+  sp = MySharedPtr<Recorder, Deferred>();
+  EXPECT_TRUE(wp.expired());
+  Deferred::reclaimer().flush();
+  EXPECT_NE(destroyed_on, std::thread::id());
+  EXPECT_NE(destroyed_on, std::this_thread::get_id());
+}
+
+struct DeferredNode {
+  TestObject payload;
+  std::vector<MySharedPtr<DeferredNode, Deferred>> children;
+};
+
+TEST(MyDeferredTest, FlushWaitsForCascades) {
+  MyReclaimer::Stats before = Deferred::reclaimer().stats();
+  {
+    MySharedPtr<DeferredNode, Deferred> root = MakeMyShared<DeferredNode, Deferred>();
+    for (int i = 0; i < 10; ++i) {
+      root->children.push_back(MakeMyShared<DeferredNode, Deferred>());
+      root->children.back()->children.push_back(MakeMyShared<DeferredNode, Deferred>());
+    }
+    EXPECT_EQ(TestObject::instances, 21);
+  }
+  Deferred::reclaimer().flush();
+  EXPECT_EQ(TestObject::instances, 0);
+
+  MyReclaimer::Stats after = Deferred::reclaimer().stats();
+  EXPECT_EQ(after.reclaimed - before.reclaimed, 21u);
+  // The root, then its children, then theirs.
+  EXPECT_GE(after.batches - before.batches, 3u);
+  EXPECT_EQ(after.queue_depth, 0u);
+  EXPECT_GE(after.max_queue_depth, 10u);
+  EXPECT_GE(after.max_latency, after.last_latency);
+}
+
+class Session : public MyEnableSharedFromThis<Session> {
+ public:
+  Session() { ++instances; }
+  Session(const Session& other) : MyEnableSharedFromThis<Session>(other) { ++instances; }
+  ~Session() { --instances; }
+
+  // What an async callback would capture to keep the session alive.
+  MySharedPtr<Session> keep_alive() { return shared_from_this(); }
+
+  static inline int instances = 0;
+};
+
+TEST(MyEnableSharedFromThisTest, SharesTheControlBlock) {
+  for (MySharedPtr<Session> owner : {MySharedPtr<Session>(new Session()), MakeMyShared<Session>()}) {
+    MySharedPtr<Session> callback = owner->keep_alive();
+    EXPECT_EQ(callback.get(), owner.get());
+    EXPECT_EQ(owner.use_count(), 3);  // owner, callback and the initializer list.
+    MyWeakPtr<Session> weak = owner->weak_from_this();
+    EXPECT_EQ(weak.use_count(), 3);
+  }
+  EXPECT_EQ(Session::instances, 0);
+}
+
+TEST(MyEnableSharedFromThisTest, CustomDeleterAndConst) {
+  int calls = 0;
+  {
+    MySharedPtr<Session> owner(new Session(), [&calls](Session* session) {
+      ++calls;
+      delete session;
+    });
+    const Session& session = *owner;
+    MySharedPtr<const Session> shared = session.shared_from_this();
+    EXPECT_EQ(owner.use_count(), 2);
+    EXPECT_FALSE(session.weak_from_this().expired());
+  }
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(MyEnableSharedFromThisTest, NotOwned) {
+  Session session;
+  EXPECT_TRUE(session.weak_from_this().expired());
+  EXPECT_THROW(session.shared_from_this(), std::bad_weak_ptr);
+
+  // A copy is a separate object with no owner.
+  MySharedPtr<Session> owner = MakeMyShared<Session>();
+  {
+    Session copy(*owner);
+    EXPECT_EQ(Session::instances, 3);
+    EXPECT_TRUE(copy.weak_from_this().expired());
+  }
+  owner = MySharedPtr<Session>();
+  EXPECT_EQ(Session::instances, 1);
+}
+
+TEST(MyEnableSharedFromThisTest, ExpiresWithTheObject) {
+  MyWeakPtr<Session> weak;
+  {
+    MySharedPtr<Session, MultiThreaded> owner = MakeMyShared<Session>();
+    weak = owner->weak_from_this();
+  }
+  EXPECT_TRUE(weak.expired());
+}
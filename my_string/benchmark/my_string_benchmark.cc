@@ -0,0 +1,246 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "allocation_counter.h"
+#include "my_string.h"
+#include "my_string_search.h"
+
+namespace {
+
+constexpr size_t kKeyStride = 16;
+
+// Formats count short keys such as "user:00001234", the size of typical map keys and tokens, each
+// null-terminated at a multiple of kKeyStride, so that building strings from them measures only
+// the strings.
+std::vector<char> MakeKeys(int64_t count) {
+  std::vector<char> keys(static_cast<size_t>(count) * kKeyStride);
+  for (int64_t i = 0; i < count; ++i) {
+    std::snprintf(&keys[static_cast<size_t>(i) * kKeyStride], kKeyStride, "user:%08lld", static_cast<long long>(i % 100000000));
+  }
+  return keys;
+}
+
+// Reports the allocations made per string as "allocs/string".
+void ReportAllocations(benchmark::State& state, size_t before) {
+  state.counters["allocs/string"] = benchmark::Counter(
+      static_cast<double>(ThreadAllocationCount() - before) / static_cast<double>(state.iterations() * state.range(0)));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Builds state.range(0) short strings into a vector reserved up front, so only the strings allocate.
+template<typename String>
+void BM_BuildShortStrings(benchmark::State& state) {
+  std::vector<char> keys = MakeKeys(state.range(0));
+  std::vector<String> strings;
+  strings.reserve(static_cast<size_t>(state.range(0)));
+  size_t before = ThreadAllocationCount();
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      strings.emplace_back(&keys[static_cast<size_t>(i) * kKeyStride]);
+    }
+    benchmark::DoNotOptimize(strings.data());
+    state.PauseTiming();
+    strings.clear();
+    state.ResumeTiming();
+  }
+  ReportAllocations(state, before);
+}
+
+// Copies state.range(0) short strings into a vector reserved up front.
+template<typename String>
+void BM_CopyShortStrings(benchmark::State& state) {
+  std::vector<char> keys = MakeKeys(state.range(0));
+  std::vector<String> source;
+  source.reserve(static_cast<size_t>(state.range(0)));
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    source.emplace_back(&keys[static_cast<size_t>(i) * kKeyStride]);
+  }
+  std::vector<String> copies;
+  copies.reserve(source.size());
+  size_t before = ThreadAllocationCount();
+  for (auto _ : state) {
+    for (const String& string : source) {
+      copies.push_back(string);
+    }
+    benchmark::DoNotOptimize(copies.data());
+    state.PauseTiming();
+    copies.clear();
+    state.ResumeTiming();
+  }
+  ReportAllocations(state, before);
+}
+
+constexpr int64_t kStrings = 10'000'000;
+
+BENCHMARK_TEMPLATE(BM_BuildShortStrings, MyString)->Arg(kStrings)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BuildShortStrings, std::string)->Arg(kStrings)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_CopyShortStrings, MyString)->Arg(kStrings)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_CopyShortStrings, std::string)->Arg(kStrings)->Unit(benchmark::kMillisecond);
+
+// A request head of state.range(0) header lines, most values too long to be stored inline.
+MyString MakeRequestHead(int64_t lines) {
+  MyString head("GET /index.html HTTP/1.1\r\n");
+  char line[96];
+  for (int64_t i = 0; i < lines; ++i) {
+    std::snprintf(line, sizeof(line), "X-Header-%lld: value %lld of a header that needs the heap\r\n",
+                  static_cast<long long>(i % 1000), static_cast<long long>(i));
+    head.append(line);
+  }
+  return head;
+}
+
+// How a parser cuts a slice out of the head: copying it into a MyString, or viewing it in place.
+struct CopySlices {
+  static MyString cut(const MyString& head, size_t pos, size_t len) { return head.substr(pos, len); }
+};
+
+struct ViewSlices {
+  static MyStringView cut(const MyString& head, size_t pos, size_t len) { return head.substr_view(pos, len); }
+};
+
+// Cuts the head into lines and each line into a name and a value, reporting "allocs/line".
+template<typename Slices>
+void BM_ParseHeaders(benchmark::State& state) {
+  MyString head = MakeRequestHead(state.range(0));
+  size_t before = ThreadAllocationCount();
+  for (auto _ : state) {
+    size_t total = 0;
+    size_t start = head.find("\r\n") + 2;
+    for (size_t end = head.find("\r\n", start); end != MyString::npos; end = head.find("\r\n", start)) {
+      size_t colon = head.find(": ", start);
+      auto name = Slices::cut(head, start, colon - start);
+      auto value = Slices::cut(head, colon + 2, end - colon - 2);
+      total += name.length() + value.length();
+      start = end + 2;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.counters["allocs/line"] = benchmark::Counter(
+      static_cast<double>(ThreadAllocationCount() - before) / static_cast<double>(state.iterations() * state.range(0)));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(head.length()));
+}
+
+constexpr int64_t kHeaderLines = 100'000;
+
+BENCHMARK_TEMPLATE(BM_ParseHeaders, CopySlices)->Arg(kHeaderLines)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ParseHeaders, ViewSlices)->Arg(kHeaderLines)->Unit(benchmark::kMillisecond);
+
+// 1 GB of log lines, built once and shared by the search benchmarks, with room to plant a
+// needle at the end without reallocating.
+std::string& LogText() {
+  static std::string text = []() {
+    constexpr size_t kBytes = size_t{1} << 30;
+    static const char* const kLevels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+    std::string log;
+    log.reserve(kBytes + 512);
+    char line[256];
+    std::mt19937 rng(1);
+    while (log.size() < kBytes) {
+      uint32_t r = static_cast<uint32_t>(rng());
+      int length = std::snprintf(line, sizeof(line),
+                                 "2026-10-17T12:%02u:%02u.%03uZ %s [worker-%02u] GET /api/v1/users/%u/orders "
+                                 "status=%u latency_ms=%u\n",
+                                 r % 60, (r >> 6) % 60, (r >> 12) % 1000, kLevels[(r >> 22) % 4], (r >> 24) % 32,
+                                 static_cast<uint32_t>(rng() % 100000), r % 7 == 0 ? 500u : 200u,
+                                 static_cast<uint32_t>(rng() % 2000));
+      log.append(line, static_cast<size_t>(length));
+    }
+    return log;
+  }();
+  return text;
+}
+
+// A needle of the given length cut from a log line, with a byte that never occurs in the log
+// put in its middle, so it matches only at the very end where it is planted. Its other bytes
+// are ordinary log text, so the first-and-last-byte filter sees realistic false positives.
+std::string MakeNeedle(size_t length) {
+  const std::string& log = LogText();
+  std::string needle = log.substr(log.size() / 2 - log.size() / 2 % 97, length);
+  needle[length / 2] = '~';
+  return needle;
+}
+
+// Finds a needle of state.range(0) bytes planted after 1 GB of log text. Search is a struct
+// whose supported() says whether it runs on this CPU, and whose find() returns the offset or
+// MyStringView::npos.
+template<typename Search>
+void BM_FindInLog(benchmark::State& state) {
+  if (!Search::supported()) {
+    state.SkipWithError("unsupported");
+    return;
+  }
+  std::string needle = MakeNeedle(static_cast<size_t>(state.range(0)));
+  std::string& text = LogText();
+  text += needle;
+  for (auto _ : state) {
+    size_t found = Search::find(text, needle);
+    if (found != text.size() - needle.size()) {
+      state.SkipWithError("needle not found at the end");
+      break;
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+  text.resize(text.size() - needle.size());
+}
+
+// MySearchEngineFor returns nullptr when the CPU lacks Level; such benchmarks are skipped.
+template<MySearchLevel Level>
+struct EngineSearch {
+  static bool supported() { return MySearchEngineFor(Level) != nullptr; }
+  static size_t find(const std::string& text, const std::string& needle) {
+    return MySearchEngineFor(Level)->find(text.data(), text.size(), needle.data(), needle.size());
+  }
+};
+
+// What MyString::find used to do.
+struct StrstrSearch {
+  static bool supported() { return true; }
+  static size_t find(const std::string& text, const std::string& needle) {
+    const char* found = std::strstr(text.c_str(), needle.c_str());
+    return found ? static_cast<size_t>(found - text.c_str()) : MyStringView::npos;
+  }
+};
+
+struct MemmemSearch {
+  static bool supported() { return true; }
+  static size_t find(const std::string& text, const std::string& needle) {
+    const void* found = memmem(text.data(), text.size(), needle.data(), needle.size());
+    return found ? static_cast<size_t>(static_cast<const char*>(found) - text.data()) : MyStringView::npos;
+  }
+};
+
+// Counts the lines of the log, the single-byte case of count().
+template<MySearchLevel Level>
+void BM_CountLines(benchmark::State& state) {
+  const MySearchEngine* engine = MySearchEngineFor(Level);
+  if (engine == nullptr) {
+    state.SkipWithError("unsupported");
+    return;
+  }
+  const std::string& text = LogText();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(engine->count(text.data(), text.size(), "\n", 1));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+
+void NeedleLengths(benchmark::internal::Benchmark* benchmark) {
+  benchmark->RangeMultiplier(2)->Range(1, 256)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_FindInLog, EngineSearch<MySearchLevel::kScalar>)->Apply(NeedleLengths);
+BENCHMARK_TEMPLATE(BM_FindInLog, EngineSearch<MySearchLevel::kSse2>)->Apply(NeedleLengths);
+BENCHMARK_TEMPLATE(BM_FindInLog, EngineSearch<MySearchLevel::kAvx2>)->Apply(NeedleLengths);
+BENCHMARK_TEMPLATE(BM_FindInLog, StrstrSearch)->Apply(NeedleLengths);
+BENCHMARK_TEMPLATE(BM_FindInLog, MemmemSearch)->Apply(NeedleLengths);
+
+BENCHMARK_TEMPLATE(BM_CountLines, MySearchLevel::kScalar)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_CountLines, MySearchLevel::kSse2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_CountLines, MySearchLevel::kAvx2)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -2,6 +2,8 @@
 
 #include <cstring>
 #include <iostream>
+#include <type_traits>
+#include "my_string_view.h"
 
 /**
  * @brief A custom string class that manages dynamic character array.
@@ -9,14 +11,22 @@
  * MyString provides basic string operations including construction, assignment,
  * concatenation, comparison, and substring operations. It manages memory
  * automatically and supports both copy and move semantics.
+ *
+ * Strings of up to kInlineCapacity (23) characters are stored inside the object,
+ * in the 24 bytes that otherwise hold the heap pointer, size and capacity, so
+ * building or copying them does not allocate. Longer strings live on the heap.
  */
 class MyString {
 public:
+  /**
+   * @brief Short strings are told apart by a tag byte, not by a pointer into the object.
+   */
+  using is_trivially_relocatable = std::true_type;
+
   /**
    * @brief Constructs an empty string.
    *
-   * Creates a string with only a null terminator, initializing size to 0
-   * and capacity to 1.
+   * Creates a string with only a null terminator, stored inline.
    */
   MyString();
 
@@ -30,6 +40,23 @@ public:
    */
   MyString(const char* str);
 
+  /**
+   * @brief Constructs string from the first count characters of str.
+   *
+   * @param str Pointer to at least count characters (can be nullptr if count is 0).
+   * @param count Number of characters to copy.
+   */
+  MyString(const char* str, size_t count);
+
+  /**
+   * @brief Constructs string from the characters of a view.
+   *
+   * Explicit, since it copies and may allocate where a view would not.
+   *
+   * @param view The characters to copy.
+   */
+  explicit MyString(MyStringView view);
+
   /**
    * @brief Copy constructor.
    *
@@ -43,8 +70,8 @@ public:
   /**
    * @brief Move constructor.
    *
-   * Transfers ownership of resources from other string,
-   * leaving it in a valid but empty state.
+   * Transfers ownership of resources from other string, or copies its inline
+   * characters, leaving it in a valid but empty state.
    *
    * @param other The MyString instance to move from.
    */
@@ -90,13 +117,21 @@ public:
   /**
    * @brief Appends a C-style string to this string.
    *
-   * Converts C-style string to MyString and delegates to append(const MyString&).
+   * Appends the characters up to the null terminator; a null str appends nothing.
    *
    * @param str The C-style string to append.
    * @return Reference to this object.
    */
   MyString& append(const char* str);
 
+  /**
+   * @brief Appends the characters of a view, which may point into this string.
+   *
+   * @param view The characters to append.
+   * @return Reference to this object.
+   */
+  MyString& append(MyStringView view);
+
   /**
    * @brief Concatenates two strings.
    *
@@ -180,6 +215,23 @@ public:
    */
   bool empty() const;
 
+  /**
+   * @brief Returns how many characters the string can hold without allocating.
+   *
+   * @return kInlineCapacity for inline strings, the size of the heap buffer
+   * (excluding null terminator) otherwise.
+   */
+  size_t capacity() const;
+
+  /**
+   * @brief Makes room for at least new_capacity characters without further allocation.
+   *
+   * Does nothing if the string can already hold that many.
+   *
+   * @param new_capacity The number of characters to make room for (excluding null terminator).
+   */
+  void reserve(size_t new_capacity);
+
   /**
    * @brief Clears the string content.
    *
@@ -190,13 +242,41 @@ public:
   /**
    * @brief Finds a substring in this string.
    *
-   * Searches for substring starting from specified position.
+   * Searches for substring starting from specified position. Takes a view, so
+   * searching for a literal or another MyString does not allocate, and uses
+   * MySearchEngineBest(), so embedded nulls are found too.
    *
    * @param str The substring to find.
    * @param pos The position to start searching from.
    * @return Position where substring was found, or npos if not found.
    */
-  size_t find(const MyString& str, size_t pos = 0) const;
+  size_t find(MyStringView str, size_t pos = 0) const;
+
+  /**
+   * @brief Finds the last occurrence of a substring.
+   *
+   * @param str The substring to find.
+   * @param pos The last position a match may start at (npos means anywhere).
+   * @return Position where substring was found, or npos if not found.
+   */
+  size_t rfind(MyStringView str, size_t pos = npos) const;
+
+  /**
+   * @brief Finds the first character that is one of the characters of set.
+   *
+   * @param set The characters to look for.
+   * @param pos The position to start searching from.
+   * @return Position of the character, or npos if there is none.
+   */
+  size_t find_first_of(MyStringView set, size_t pos = 0) const;
+
+  /**
+   * @brief Counts the non-overlapping occurrences of a substring.
+   *
+   * @param str The substring to count; an empty one counts 0.
+   * @return The number of occurrences.
+   */
+  size_t count(MyStringView str) const;
 
   /**
    * @brief Extracts a substring.
@@ -209,23 +289,118 @@ public:
    */
   MyString substr(size_t pos, size_t len = npos) const;
 
+  /**
+   * @brief Returns a view of a substring, without copying.
+   *
+   * The view is valid until this string is destroyed or reallocates.
+   *
+   * @param pos Starting position of substring.
+   * @param len Length of substring (npos means until end of string).
+   * @return A view into this string's characters.
+   */
+  MyStringView substr_view(size_t pos, size_t len = npos) const;
+
+  /**
+   * @brief Returns a view of the whole string.
+   *
+   * The view is valid until this string is destroyed or reallocates.
+   */
+  MyStringView view() const;
+
+  /**
+   * @brief Converts to a view of the whole string, so a MyString can be passed
+   * wherever a MyStringView is expected.
+   */
+  operator MyStringView() const;
+
   // Stream operators
   friend std::ostream& operator<<(std::ostream& os, const MyString& str);
   friend std::istream& operator>>(std::istream& is, MyString& str);
 
   static const size_t npos;  // Represents not found or invalid position
+  static constexpr size_t kInlineCapacity = sizeof(char*) + 2 * sizeof(size_t) - 1;  // Longest string stored inline
 
 private:
-  char* data_;       // Pointer to character array
-  size_t size_;      // Length of string (excluding null terminator)
-  size_t capacity_;  // Allocated memory size
+  struct Heap {
+    char* data;       // Pointer to character array
+    size_t size;      // Length of string (excluding null terminator)
+    size_t capacity;  // Allocated characters (excluding null terminator), tagged by EncodeCapacity()
+  };
+  static_assert(sizeof(Heap) == kInlineCapacity + 1, "Heap must have no padding");
+
+  // The last byte of the object is the tag. An inline string keeps kInlineCapacity - size there,
+  // which has the high bit clear and doubles as the null terminator of a full inline string. A
+  // heap string keeps the high byte of its capacity there, with the high bit set.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  static constexpr unsigned kTagShift = 0;
+  static constexpr unsigned kCapacityShift = 8;
+#else
+  static constexpr unsigned kTagShift = (sizeof(size_t) - 1) * 8;
+  static constexpr unsigned kCapacityShift = 0;
+#endif
+  static constexpr size_t kHeapTag = size_t{0x80} << kTagShift;
+  static constexpr size_t kTagMask = size_t{0xff} << kTagShift;
+
+  static size_t EncodeCapacity(size_t capacity) {
+    return (capacity << kCapacityShift) | kHeapTag;
+  }
+
+  static size_t DecodeCapacity(size_t encoded) {
+    return (encoded & ~kTagMask) >> kCapacityShift;
+  }
+
+  union {
+    Heap heap_;                      // Active for long strings
+    char inline_[sizeof(Heap)];      // Active for short strings; the last byte is the tag
+  };
+
+  bool is_inline() const {
+    return (static_cast<unsigned char>(inline_[kInlineCapacity]) & 0x80) == 0;
+  }
+
+  char* data() {
+    return is_inline() ? inline_ : heap_.data;
+  }
+
+  const char* data() const {
+    return is_inline() ? inline_ : heap_.data;
+  }
 
   /**
-   * @brief Reallocates internal buffer to new capacity.
-   *
-   * Allocates new memory, copies existing content, and updates capacity.
+   * @brief Sets the length of the string and writes its null terminator.
+   */
+  void set_size(size_t size);
+
+  /**
+   * @brief Becomes an empty inline string, without freeing anything.
+   */
+  void set_empty();
+
+  /**
+   * @brief Initializes the string to a copy of count characters, inline if they fit.
+   */
+  void init(const char* str, size_t count);
+
+  /**
+   * @brief Appends count characters, which may point into this string.
    *
-   * @param new_capacity The new capacity to allocate.
+   * Moves to a larger heap buffer if necessary, at least doubling the capacity.
    */
-  void reallocate(size_t new_capacity);
-};
\ No newline at end of file
+  MyString& append(const char* str, size_t count);
+};
+
+static_assert(sizeof(MyString) == 3 * sizeof(size_t), "the inline layout must not grow MyString");
+
+namespace std {
+
+/**
+ * @brief Hashes the characters of a MyString, the same as a MyStringView of them.
+ */
+template<>
+struct hash<MyString> {
+  size_t operator()(const MyString& str) const noexcept {
+    return hash<MyStringView>()(str.view());
+  }
+};
+
+}  // namespace std
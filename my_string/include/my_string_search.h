@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief The instruction sets a MySearchEngine can be built on, from slowest to fastest.
+ */
+enum class MySearchLevel {
+  kScalar,  ///< Portable C++ only.
+  kSse2,    ///< 16 bytes per step; part of every x86-64 CPU.
+  kAvx2,    ///< 32 bytes per step.
+};
+
+/**
+ * @brief A set of length-aware search routines over raw character ranges, built for one
+ * MySearchLevel.
+ *
+ * Every routine takes the haystack and its length, so it is not stopped by embedded nulls, and
+ * returns an offset into the haystack, or MyStringView::npos when there is no match.
+ *
+ * find() filters candidate positions with the needle's first, middle and last bytes, a whole
+ * vector of positions at a time, and confirms candidates with memcmp. The middle byte keeps
+ * structured text fast: in log lines, a first and a last byte often line up on every line.
+ * Needles longer than kLongNeedle are searched with Horspool's algorithm instead, which skips
+ * ahead by up to the needle length. The scalar engine finds candidates with memchr instead.
+ * Both approaches degrade towards O(size * needle_size) on adversarial, highly repetitive input.
+ *
+ * MyStringView and MyString call MySearchEngineBest(). The other engines are reachable through
+ * MySearchEngineFor() for tests and benchmarks.
+ */
+struct MySearchEngine {
+  static constexpr size_t kLongNeedle = 256;  ///< Longest needle for the byte filter.
+
+  MySearchLevel level;
+  const char* name;
+
+  /**
+   * @brief Finds the first occurrence of needle in haystack; an empty needle is found at 0.
+   */
+  size_t (*find)(const char* haystack, size_t size, const char* needle, size_t needle_size) noexcept;
+
+  /**
+   * @brief Finds the first character of haystack that is one of the set_size characters of set.
+   */
+  size_t (*find_first_of)(const char* haystack, size_t size, const char* set, size_t set_size) noexcept;
+
+  /**
+   * @brief Counts the non-overlapping occurrences of needle in haystack; an empty needle counts 0.
+   */
+  size_t (*count)(const char* haystack, size_t size, const char* needle, size_t needle_size) noexcept;
+};
+
+/**
+ * @brief Retrieves the engine for a level, or nullptr if the CPU or the build does not support it.
+ */
+const MySearchEngine* MySearchEngineFor(MySearchLevel level) noexcept;
+
+/**
+ * @brief Retrieves the fastest engine the CPU supports, chosen by CPUID on first use.
+ */
+const MySearchEngine& MySearchEngineBest() noexcept;
+
+/**
+ * @brief Finds the last occurrence of needle in haystack; an empty needle is found at size.
+ *
+ * Scans backwards with a first-and-last-byte check. It is not vectorized, since backward
+ * searches are rare compared to forward ones.
+ */
+size_t MySearchReverseFind(const char* haystack, size_t size, const char* needle, size_t needle_size) noexcept;
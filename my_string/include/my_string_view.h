@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string_view>
+#include <type_traits>
+#include "my_string_search.h"
+
+/**
+ * @brief A non-owning reference to a range of characters.
+ *
+ * MyStringView is a pointer and a length. Copying, slicing and searching it never allocates,
+ * which makes it the type to pass around when code only reads characters, such as a parser
+ * cutting a request buffer into tokens. The characters are not required to be null-terminated.
+ *
+ * A view does not keep its characters alive: it must not outlive the buffer or MyString it
+ * refers to, and becomes dangling if that string is modified so that it reallocates.
+ */
+class MyStringView {
+public:
+  /**
+   * @brief A pointer and a length.
+   */
+  using is_trivially_relocatable = std::true_type;
+
+  static constexpr size_t npos = static_cast<size_t>(-1);  // Represents not found or invalid position
+
+  /**
+   * @brief Constructs an empty view.
+   */
+  constexpr MyStringView() noexcept : data_(nullptr), size_(0) {}
+
+  /**
+   * @brief Constructs a view of count characters starting at str.
+   *
+   * @param str Pointer to at least count characters (can be nullptr if count is 0).
+   * @param count Number of characters in the view.
+   */
+  constexpr MyStringView(const char* str, size_t count) noexcept : data_(str), size_(count) {}
+
+  /**
+   * @brief Constructs a view of a null-terminated string, excluding the terminator.
+   *
+   * @param str Pointer to null-terminated string (can be nullptr).
+   */
+  MyStringView(const char* str) noexcept : data_(str), size_(str ? strlen(str) : 0) {}
+
+  /**
+   * @brief Returns pointer to the first character, which need not be followed by a null terminator.
+   */
+  constexpr const char* data() const noexcept {
+    return data_;
+  }
+
+  /**
+   * @brief Returns the number of characters in the view.
+   */
+  constexpr size_t length() const noexcept {
+    return size_;
+  }
+
+  /**
+   * @brief Checks if the view is empty.
+   */
+  constexpr bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /**
+   * @brief Provides read-only access to the character at pos.
+   */
+  const char& operator[](size_t pos) const noexcept {
+    assert(pos < size_);
+    return data_[pos];
+  }
+
+  /**
+   * @brief Drops the first count characters from the view.
+   */
+  void remove_prefix(size_t count) noexcept {
+    assert(count <= size_);
+    data_ += count;
+    size_ -= count;
+  }
+
+  /**
+   * @brief Drops the last count characters from the view.
+   */
+  void remove_suffix(size_t count) noexcept {
+    assert(count <= size_);
+    size_ -= count;
+  }
+
+  /**
+   * @brief Returns a view of a range of characters of this view.
+   *
+   * Like MyString::substr, out-of-range positions give an empty view rather than an error.
+   *
+   * @param pos Starting position of the range.
+   * @param len Length of the range (npos means until end of view).
+   * @return A view into the same characters.
+   */
+  MyStringView substr(size_t pos, size_t len = npos) const noexcept {
+    if (pos > size_) return MyStringView();
+    return MyStringView(data_ + pos, len < size_ - pos ? len : size_ - pos);
+  }
+
+  /**
+   * @brief Finds the first occurrence of needle at or after pos.
+   *
+   * Uses MySearchEngineBest(), so it is length-aware and vectorized where the CPU allows.
+   *
+   * @param needle The characters to find.
+   * @param pos The position to start searching from.
+   * @return Position where needle was found, or npos if not found.
+   */
+  size_t find(MyStringView needle, size_t pos = 0) const noexcept {
+    if (pos > size_) return npos;
+    size_t found = MySearchEngineBest().find(data_ + pos, size_ - pos, needle.data_, needle.size_);
+    return found == npos ? npos : pos + found;
+  }
+
+  /**
+   * @brief Finds the last occurrence of needle that starts at or before pos.
+   *
+   * @param needle The characters to find.
+   * @param pos The last position a match may start at (npos means anywhere).
+   * @return Position where needle was found, or npos if not found.
+   */
+  size_t rfind(MyStringView needle, size_t pos = npos) const noexcept {
+    if (needle.size_ > size_) return npos;
+    size_t end = pos < size_ - needle.size_ ? pos + needle.size_ : size_;
+    return MySearchReverseFind(data_, end, needle.data_, needle.size_);
+  }
+
+  /**
+   * @brief Finds the first character at or after pos that is one of the characters of set.
+   *
+   * @param set The characters to look for.
+   * @param pos The position to start searching from.
+   * @return Position of the character, or npos if there is none.
+   */
+  size_t find_first_of(MyStringView set, size_t pos = 0) const noexcept {
+    if (pos > size_) return npos;
+    size_t found = MySearchEngineBest().find_first_of(data_ + pos, size_ - pos, set.data_, set.size_);
+    return found == npos ? npos : pos + found;
+  }
+
+  /**
+   * @brief Counts the non-overlapping occurrences of needle.
+   *
+   * @param needle The characters to count; an empty needle counts 0.
+   * @return The number of occurrences.
+   */
+  size_t count(MyStringView needle) const noexcept {
+    return MySearchEngineBest().count(data_, size_, needle.data_, needle.size_);
+  }
+
+  /**
+   * @brief Lexicographically compares two views, as unsigned characters.
+   *
+   * @return A negative value, zero or a positive value if this view is less than, equal to or
+   * greater than other.
+   */
+  int compare(MyStringView other) const noexcept {
+    size_t common = size_ < other.size_ ? size_ : other.size_;
+    int result = common ? memcmp(data_, other.data_, common) : 0;
+    if (result != 0) return result;
+    return size_ < other.size_ ? -1 : (size_ > other.size_ ? 1 : 0);
+  }
+
+  friend bool operator==(MyStringView lhs, MyStringView rhs) noexcept {
+    return lhs.size_ == rhs.size_ && (lhs.size_ == 0 || memcmp(lhs.data_, rhs.data_, lhs.size_) == 0);
+  }
+
+  friend bool operator!=(MyStringView lhs, MyStringView rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator<(MyStringView lhs, MyStringView rhs) noexcept {
+    return lhs.compare(rhs) < 0;
+  }
+
+  friend bool operator<=(MyStringView lhs, MyStringView rhs) noexcept {
+    return lhs.compare(rhs) <= 0;
+  }
+
+  friend bool operator>(MyStringView lhs, MyStringView rhs) noexcept {
+    return lhs.compare(rhs) > 0;
+  }
+
+  friend bool operator>=(MyStringView lhs, MyStringView rhs) noexcept {
+    return lhs.compare(rhs) >= 0;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, MyStringView view) {
+    return os.write(view.data_, static_cast<std::streamsize>(view.size_));
+  }
+
+private:
+  const char* data_;  // Pointer to the first character
+  size_t size_;       // Number of characters
+};
+
+/**
+ * @brief Hashes the characters of a MyStringView, so views can key unordered containers.
+ *
+ * Uses the standard library's byte hash, so equal views hash alike no matter where their
+ * characters live, and the same as MyString.
+ */
+namespace std {
+
+template<>
+struct hash<MyStringView> {
+  size_t operator()(MyStringView view) const noexcept {
+    return hash<string_view>()(string_view(view.data(), view.length()));
+  }
+};
+
+}  // namespace std
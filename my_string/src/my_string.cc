@@ -2,58 +2,60 @@
 #include <algorithm>
 #include <cstring>
 #include <cassert>
+#include <utility>
 
 // Define static member
 const size_t MyString::npos = static_cast<size_t>(-1);
 
 // Default constructor
-MyString::MyString() : data_(new char[1]), size_(0), capacity_(1) {
-  data_[0] = '\0';
+MyString::MyString() {
+  set_empty();
 }
 
 // Construct from C-style string
 MyString::MyString(const char* str) {
-  if (str) {
-    size_ = strlen(str);
-    capacity_ = size_ + 1;
-    data_ = new char[capacity_];
-    memcpy(data_, str, size_ + 1);
-  } else {
-    data_ = new char[1];
-    data_[0] = '\0';
-    size_ = 0;
-    capacity_ = 1;
-  }
+  init(str, str ? strlen(str) : 0);
+}
+
+// Construct from a character range
+MyString::MyString(const char* str, size_t count) {
+  init(str, count);
+}
+
+// Construct from a view
+MyString::MyString(MyStringView view) {
+  init(view.data(), view.length());
 }
 
 // Copy constructor
-MyString::MyString(const MyString& other) 
-    : size_(other.size_), capacity_(other.capacity_) {
-  data_ = new char[capacity_];
-  memcpy(data_, other.data_, size_ + 1);
+MyString::MyString(const MyString& other) {
+  init(other.data(), other.length());
 }
 
 // Move constructor
-MyString::MyString(MyString&& other) noexcept
-    : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
-  other.data_ = nullptr;
-  other.size_ = 0;
-  other.capacity_ = 0;
+MyString::MyString(MyString&& other) noexcept {
+  memcpy(static_cast<void*>(this), &other, sizeof(MyString));
+  other.set_empty();
 }
 
 // Destructor
 MyString::~MyString() {
-  delete[] data_;
+  if (!is_inline()) {
+    delete[] heap_.data;
+  }
 }
 
 // Copy assignment operator
 MyString& MyString::operator=(const MyString& other) {
   if (this != &other) {
-    delete[] data_;
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    data_ = new char[capacity_];
-    memcpy(data_, other.data_, size_ + 1);
+    if (other.length() <= capacity()) {
+      // Reuse the buffer we have, inline or not.
+      memcpy(data(), other.data(), other.length());
+      set_size(other.length());
+    } else {
+      MyString copy(other);
+      *this = std::move(copy);
+    }
   }
   return *this;
 }
@@ -61,40 +63,89 @@ MyString& MyString::operator=(const MyString& other) {
 // Move assignment operator
 MyString& MyString::operator=(MyString&& other) noexcept {
   if (this != &other) {
-    delete[] data_;
-    data_ = other.data_;
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    other.data_ = nullptr;
-    other.size_ = 0;
-    other.capacity_ = 0;
+    if (!is_inline()) {
+      delete[] heap_.data;
+    }
+    memcpy(static_cast<void*>(this), &other, sizeof(MyString));
+    other.set_empty();
   }
   return *this;
 }
 
-// Reallocate memory with new capacity
-void MyString::reallocate(size_t new_capacity) {
-  char* new_data = new char[new_capacity];
-  memcpy(new_data, data_, size_ + 1);
-  delete[] data_;
-  data_ = new_data;
-  capacity_ = new_capacity;
+// Set length and null terminator
+void MyString::set_size(size_t size) {
+  if (is_inline()) {
+    inline_[size] = '\0';
+    // For a full inline string this writes the terminator a second time, as the tag.
+    inline_[kInlineCapacity] = static_cast<char>(kInlineCapacity - size);
+  } else {
+    heap_.data[size] = '\0';
+    heap_.size = size;
+  }
 }
 
-// Append another string
-MyString& MyString::append(const MyString& str) {
-  size_t new_size = size_ + str.size_;
-  if (new_size >= capacity_) {
-    reallocate(new_size * 2 + 1);
+// Become an empty inline string
+void MyString::set_empty() {
+  inline_[0] = '\0';
+  inline_[kInlineCapacity] = static_cast<char>(kInlineCapacity);
+}
+
+// Initialize from a character range
+void MyString::init(const char* str, size_t count) {
+  if (count <= kInlineCapacity) {
+    set_empty();
+    if (count > 0) {
+      memcpy(inline_, str, count);
+    }
+    set_size(count);
+  } else {
+    heap_.data = new char[count + 1];
+    memcpy(heap_.data, str, count);
+    heap_.data[count] = '\0';
+    heap_.size = count;
+    heap_.capacity = EncodeCapacity(count);
+  }
+}
+
+// Append a character range
+MyString& MyString::append(const char* str, size_t count) {
+  size_t size = length();
+  size_t new_size = size + count;
+  if (new_size > capacity()) {
+    size_t new_capacity = std::max(new_size, capacity() * 2);
+    char* new_data = new char[new_capacity + 1];
+    memcpy(new_data, data(), size);
+    // str may point into the old buffer, which is still alive here.
+    memcpy(new_data + size, str, count);
+    new_data[new_size] = '\0';
+    if (!is_inline()) {
+      delete[] heap_.data;
+    }
+    heap_.data = new_data;
+    heap_.size = new_size;
+    heap_.capacity = EncodeCapacity(new_capacity);
+  } else {
+    // str may overlap the destination only when appending a string to itself, which is fine
+    // for memmove.
+    memmove(data() + size, str, count);
+    set_size(new_size);
   }
-  memcpy(data_ + size_, str.data_, str.size_ + 1);
-  size_ = new_size;
   return *this;
 }
 
+// Append another string
+MyString& MyString::append(const MyString& str) {
+  return append(str.data(), str.length());
+}
+
 // Append C-style string
 MyString& MyString::append(const char* str) {
-  return append(MyString(str));
+  return str ? append(str, strlen(str)) : *this;
+}
+
+// Append a view
+MyString& MyString::append(MyStringView view) {
+  return append(view.data(), view.length());
 }
 
 // String concatenation
@@ -106,7 +157,7 @@ MyString MyString::operator+(const MyString& other) const {
 
 // Equality comparison
 bool MyString::operator==(const MyString& other) const {
-  return size_ == other.size_ && strcmp(data_, other.data_) == 0;
+  return length() == other.length() && memcmp(data(), other.data(), length()) == 0;
 }
 
 // Inequality comparison
@@ -116,67 +167,103 @@ bool MyString::operator!=(const MyString& other) const {
 
 // Less than comparison
 bool MyString::operator<(const MyString& other) const {
-  return strcmp(data_, other.data_) < 0;
+  return view().compare(other.view()) < 0;
 }
 
 // Array subscript operator
 char& MyString::operator[](size_t pos) {
-  assert(pos < size_);
-  return data_[pos];
+  assert(pos < length());
+  return data()[pos];
 }
 
 // Const array subscript operator
 const char& MyString::operator[](size_t pos) const {
-  assert(pos < size_);
-  return data_[pos];
+  assert(pos < length());
+  return data()[pos];
 }
 
 // Get C-style string
 const char* MyString::c_str() const {
-  return data_;
+  return data();
 }
 
 // Get string length
 size_t MyString::length() const {
-  return size_;
+  return is_inline() ? kInlineCapacity - static_cast<unsigned char>(inline_[kInlineCapacity]) : heap_.size;
 }
 
 // Check if string is empty
 bool MyString::empty() const {
-  return size_ == 0;
+  return length() == 0;
+}
+
+// Get capacity
+size_t MyString::capacity() const {
+  return is_inline() ? kInlineCapacity : DecodeCapacity(heap_.capacity);
+}
+
+// Reserve capacity
+void MyString::reserve(size_t new_capacity) {
+  if (new_capacity <= capacity()) return;
+  size_t size = length();
+  char* new_data = new char[new_capacity + 1];
+  memcpy(new_data, data(), size + 1);
+  if (!is_inline()) {
+    delete[] heap_.data;
+  }
+  heap_.data = new_data;
+  heap_.size = size;
+  heap_.capacity = EncodeCapacity(new_capacity);
 }
 
 // Clear string content
 void MyString::clear() {
-  data_[0] = '\0';
-  size_ = 0;
+  set_size(0);
 }
 
 // Find substring
-size_t MyString::find(const MyString& str, size_t pos) const {
-  if (pos > size_) return npos;
-  const char* result = strstr(data_ + pos, str.data_);
-  return result ? result - data_ : npos;
+size_t MyString::find(MyStringView str, size_t pos) const {
+  return view().find(str, pos);
+}
+
+// Find last occurrence of substring
+size_t MyString::rfind(MyStringView str, size_t pos) const {
+  return view().rfind(str, pos);
+}
+
+// Find first of a set of characters
+size_t MyString::find_first_of(MyStringView set, size_t pos) const {
+  return view().find_first_of(set, pos);
+}
+
+// Count occurrences of substring
+size_t MyString::count(MyStringView str) const {
+  return view().count(str);
 }
 
 // Get substring
 MyString MyString::substr(size_t pos, size_t len) const {
-  if (pos > size_) return MyString();
-  if (len == npos || pos + len > size_) {
-    len = size_ - pos;
-  }
-  
-  char* temp = new char[len + 1];
-  memcpy(temp, data_ + pos, len);
-  temp[len] = '\0';
-  MyString result(temp);
-  delete[] temp;
-  return result;
+  return MyString(substr_view(pos, len));
+}
+
+// Get substring without copying
+MyStringView MyString::substr_view(size_t pos, size_t len) const {
+  return view().substr(pos, len);
+}
+
+// Get view of the whole string
+MyStringView MyString::view() const {
+  return MyStringView(data(), length());
+}
+
+// Convert to view
+MyString::operator MyStringView() const {
+  return view();
 }
 
 // Stream output operator
 std::ostream& operator<<(std::ostream& os, const MyString& str) {
-  return os << str.data_;
+  return os.write(str.data(), static_cast<std::streamsize>(str.length()));
 }
 
 // Stream input operator
@@ -0,0 +1,297 @@
+#include "my_string_search.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MY_SEARCH_X86 1
+#endif
+
+namespace {
+
+constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+// Horspool's algorithm: compare the haystack byte under the needle's last position, and on a
+// mismatch shift the needle so that its last occurrence of that byte lines up with it.
+size_t FindLong(const char* haystack, size_t size, const char* needle, size_t needle_size) noexcept {
+  size_t shift[256];
+  for (size_t& s : shift) {
+    s = needle_size;
+  }
+  for (size_t i = 0; i + 1 < needle_size; ++i) {
+    shift[static_cast<unsigned char>(needle[i])] = needle_size - 1 - i;
+  }
+  const char last = needle[needle_size - 1];
+  for (size_t pos = 0; pos + needle_size <= size;) {
+    char c = haystack[pos + needle_size - 1];
+    if (c == last && memcmp(haystack + pos, needle, needle_size - 1) == 0) {
+      return pos;
+    }
+    pos += shift[static_cast<unsigned char>(c)];
+  }
+  return kNotFound;
+}
+
+size_t FindByte(const char* haystack, size_t size, char c) noexcept {
+  const void* at = memchr(haystack, c, size);
+  return at ? static_cast<size_t>(static_cast<const char*>(at) - haystack) : kNotFound;
+}
+
+// Tries candidate positions from pos on one at a time; vector engines use it for their tail.
+size_t FindShortFrom(const char* haystack, size_t size, const char* needle, size_t needle_size, size_t pos) noexcept {
+  const char* last = haystack + (size - needle_size);
+  for (const char* at = haystack + pos; at <= last; ++at) {
+    at = static_cast<const char*>(memchr(at, needle[0], static_cast<size_t>(last - at) + 1));
+    if (!at) break;
+    if (at[needle_size - 1] == needle[needle_size - 1] && memcmp(at + 1, needle + 1, needle_size - 2) == 0) {
+      return static_cast<size_t>(at - haystack);
+    }
+  }
+  return kNotFound;
+}
+
+size_t FindScalar(const char* haystack, size_t size, const char* needle, size_t needle_size) noexcept {
+  if (needle_size == 0) return 0;
+  if (needle_size > size) return kNotFound;
+  if (needle_size == 1) return FindByte(haystack, size, needle[0]);
+  if (needle_size > MySearchEngine::kLongNeedle) return FindLong(haystack, size, needle, needle_size);
+  return FindShortFrom(haystack, size, needle, needle_size, 0);
+}
+
+// Looks every byte up in a 256-entry membership table.
+size_t FindFirstOfTable(const char* haystack, size_t size, const char* set, size_t set_size, size_t pos) noexcept {
+  bool member[256] = {};
+  for (size_t i = 0; i < set_size; ++i) {
+    member[static_cast<unsigned char>(set[i])] = true;
+  }
+  for (; pos < size; ++pos) {
+    if (member[static_cast<unsigned char>(haystack[pos])]) return pos;
+  }
+  return kNotFound;
+}
+
+size_t FindFirstOfScalar(const char* haystack, size_t size, const char* set, size_t set_size) noexcept {
+  if (set_size == 0) return kNotFound;
+  if (set_size == 1) return FindByte(haystack, size, set[0]);
+  return FindFirstOfTable(haystack, size, set, set_size, 0);
+}
+
+// Counts by searching again right after each match, so matches do not overlap.
+template<size_t (*Find)(const char*, size_t, const char*, size_t) noexcept>
+size_t CountMatches(const char* haystack, size_t size, const char* needle, size_t needle_size) noexcept {
+  size_t count = 0;
+  for (size_t pos = 0; pos + needle_size <= size; ++count) {
+    size_t found = Find(haystack + pos, size - pos, needle, needle_size);
+    if (found == kNotFound) break;
+    pos += found + needle_size;
+  }
+  return count;
+}
+
+size_t CountByteFrom(const char* haystack, size_t size, char c, size_t pos) noexcept {
+  size_t count = 0;
+  for (; pos < size; ++pos) {
+    count += haystack[pos] == c;
+  }
+  return count;
+}
+
+size_t CountScalar(const char* haystack, size_t size, const char* needle, size_t needle_size) noexcept {
+  if (needle_size == 0) return 0;
+  if (needle_size == 1) return CountByteFrom(haystack, size, needle[0], 0);
+  return CountMatches<FindScalar>(haystack, size, needle, needle_size);
+}
+
+#ifdef MY_SEARCH_X86
+
+// The vector engines test a vector of candidate positions per load: the bytes at the positions,
+// at the positions plus needle_size / 2 and plus needle_size - 1 are compared with the needle's
+// first, middle and last byte, and only positions where all three match reach memcmp. Sets of up
+// to kMaxVectorSet characters for find_first_of are compared one character per instruction.
+constexpr size_t kMaxVectorSet = 16;
+
+size_t FindSse2(const char* haystack, size_t size, const char* needle, size_t needle_size) noexcept {
+  if (needle_size == 0) return 0;
+  if (needle_size > size) return kNotFound;
+  if (needle_size == 1) return FindByte(haystack, size, needle[0]);
+  if (needle_size > MySearchEngine::kLongNeedle) return FindLong(haystack, size, needle, needle_size);
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i middle = _mm_set1_epi8(needle[needle_size / 2]);
+  const __m128i last = _mm_set1_epi8(needle[needle_size - 1]);
+  const size_t half = needle_size / 2;
+  const size_t offset = needle_size - 1;
+  size_t pos = 0;
+  // Two vectors per step, so the loop branches once per 32 positions.
+  for (; pos + offset + 32 <= size; pos += 32) {
+    const char* at = haystack + pos;
+    __m128i hits_low = _mm_and_si128(
+        _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(at)), first),
+                      _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(at + half)), middle)),
+        _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(at + offset)), last));
+    __m128i hits_high = _mm_and_si128(
+        _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(at + 16)), first),
+                      _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(at + 16 + half)), middle)),
+        _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(at + 16 + offset)), last));
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits_low)) |
+                    static_cast<uint32_t>(_mm_movemask_epi8(hits_high)) << 16;
+    for (; mask != 0; mask &= mask - 1) {
+      size_t candidate = pos + static_cast<size_t>(__builtin_ctz(mask));
+      if (memcmp(haystack + candidate + 1, needle + 1, needle_size - 2) == 0) return candidate;
+    }
+  }
+  return FindShortFrom(haystack, size, needle, needle_size, pos);
+}
+
+size_t FindFirstOfSse2(const char* haystack, size_t size, const char* set, size_t set_size) noexcept {
+  if (set_size == 0) return kNotFound;
+  if (set_size == 1) return FindByte(haystack, size, set[0]);
+  if (set_size > kMaxVectorSet) return FindFirstOfTable(haystack, size, set, set_size, 0);
+  __m128i members[kMaxVectorSet];
+  for (size_t i = 0; i < set_size; ++i) {
+    members[i] = _mm_set1_epi8(set[i]);
+  }
+  size_t pos = 0;
+  for (; pos + 16 <= size; pos += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos));
+    __m128i hits = _mm_cmpeq_epi8(block, members[0]);
+    for (size_t i = 1; i < set_size; ++i) {
+      hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, members[i]));
+    }
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+    if (mask != 0) return pos + static_cast<size_t>(__builtin_ctz(mask));
+  }
+  return FindFirstOfTable(haystack, size, set, set_size, pos);
+}
+
+size_t CountSse2(const char* haystack, size_t size, const char* needle, size_t needle_size) noexcept {
+  if (needle_size == 0) return 0;
+  if (needle_size > 1) return CountMatches<FindSse2>(haystack, size, needle, needle_size);
+  const __m128i c = _mm_set1_epi8(needle[0]);
+  size_t count = 0;
+  size_t pos = 0;
+  for (; pos + 16 <= size; pos += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos));
+    count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, c)))));
+  }
+  return count + CountByteFrom(haystack, size, needle[0], pos);
+}
+
+__attribute__((target("avx2"))) size_t FindAvx2(const char* haystack, size_t size, const char* needle,
+                                                size_t needle_size) noexcept {
+  if (needle_size == 0) return 0;
+  if (needle_size > size) return kNotFound;
+  if (needle_size == 1) return FindByte(haystack, size, needle[0]);
+  if (needle_size > MySearchEngine::kLongNeedle) return FindLong(haystack, size, needle, needle_size);
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i middle = _mm256_set1_epi8(needle[needle_size / 2]);
+  const __m256i last = _mm256_set1_epi8(needle[needle_size - 1]);
+  const size_t half = needle_size / 2;
+  const size_t offset = needle_size - 1;
+  size_t pos = 0;
+  // Two vectors per step, so the loop branches once per 64 positions.
+  for (; pos + offset + 64 <= size; pos += 64) {
+    const char* at = haystack + pos;
+    __m256i hits_low = _mm256_and_si256(
+        _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(at)), first),
+                         _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(at + half)), middle)),
+        _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(at + offset)), last));
+    __m256i hits_high = _mm256_and_si256(
+        _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(at + 32)), first),
+                         _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(at + 32 + half)), middle)),
+        _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(at + 32 + offset)), last));
+    uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits_low)) |
+                    static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hits_high))) << 32;
+    for (; mask != 0; mask &= mask - 1) {
+      size_t candidate = pos + static_cast<size_t>(__builtin_ctzll(mask));
+      if (memcmp(haystack + candidate + 1, needle + 1, needle_size - 2) == 0) return candidate;
+    }
+  }
+  return FindShortFrom(haystack, size, needle, needle_size, pos);
+}
+
+__attribute__((target("avx2"))) size_t FindFirstOfAvx2(const char* haystack, size_t size, const char* set,
+                                                       size_t set_size) noexcept {
+  if (set_size == 0) return kNotFound;
+  if (set_size == 1) return FindByte(haystack, size, set[0]);
+  if (set_size > kMaxVectorSet) return FindFirstOfTable(haystack, size, set, set_size, 0);
+  __m256i members[kMaxVectorSet];
+  for (size_t i = 0; i < set_size; ++i) {
+    members[i] = _mm256_set1_epi8(set[i]);
+  }
+  size_t pos = 0;
+  for (; pos + 32 <= size; pos += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + pos));
+    __m256i hits = _mm256_cmpeq_epi8(block, members[0]);
+    for (size_t i = 1; i < set_size; ++i) {
+      hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, members[i]));
+    }
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+    if (mask != 0) return pos + static_cast<size_t>(__builtin_ctz(mask));
+  }
+  return FindFirstOfTable(haystack, size, set, set_size, pos);
+}
+
+__attribute__((target("avx2,popcnt"))) size_t CountAvx2(const char* haystack, size_t size, const char* needle,
+                                                        size_t needle_size) noexcept {
+  if (needle_size == 0) return 0;
+  if (needle_size > 1) return CountMatches<FindAvx2>(haystack, size, needle, needle_size);
+  const __m256i c = _mm256_set1_epi8(needle[0]);
+  size_t count = 0;
+  size_t pos = 0;
+  for (; pos + 32 <= size; pos += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + pos));
+    count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, c)))));
+  }
+  return count + CountByteFrom(haystack, size, needle[0], pos);
+}
+
+#endif  // MY_SEARCH_X86
+
+constexpr MySearchEngine kScalarEngine{MySearchLevel::kScalar, "scalar", FindScalar, FindFirstOfScalar, CountScalar};
+#ifdef MY_SEARCH_X86
+constexpr MySearchEngine kSse2Engine{MySearchLevel::kSse2, "sse2", FindSse2, FindFirstOfSse2, CountSse2};
+constexpr MySearchEngine kAvx2Engine{MySearchLevel::kAvx2, "avx2", FindAvx2, FindFirstOfAvx2, CountAvx2};
+#endif
+
+}  // namespace
+
+const MySearchEngine* MySearchEngineFor(MySearchLevel level) noexcept {
+#ifdef MY_SEARCH_X86
+  // Needed when called before libgcc's own constructors, e.g. from another static initializer.
+  __builtin_cpu_init();
+#endif
+  switch (level) {
+    case MySearchLevel::kScalar:
+      return &kScalarEngine;
+#ifdef MY_SEARCH_X86
+    case MySearchLevel::kSse2:
+      return __builtin_cpu_supports("sse2") ? &kSse2Engine : nullptr;
+    case MySearchLevel::kAvx2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt") ? &kAvx2Engine : nullptr;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+const MySearchEngine& MySearchEngineBest() noexcept {
+  static const MySearchEngine* best = []() {
+    if (const MySearchEngine* avx2 = MySearchEngineFor(MySearchLevel::kAvx2)) return avx2;
+    if (const MySearchEngine* sse2 = MySearchEngineFor(MySearchLevel::kSse2)) return sse2;
+    return &kScalarEngine;
+  }();
+  return *best;
+}
+
+size_t MySearchReverseFind(const char* haystack, size_t size, const char* needle, size_t needle_size) noexcept {
+  if (needle_size > size) return kNotFound;
+  if (needle_size == 0) return size;
+  for (size_t pos = size - needle_size + 1; pos-- > 0;) {
+    if (haystack[pos] == needle[0] && haystack[pos + needle_size - 1] == needle[needle_size - 1] &&
+        memcmp(haystack + pos, needle, needle_size) == 0) {
+      return pos;
+    }
+  }
+  return kNotFound;
+}
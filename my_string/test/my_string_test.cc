@@ -1,5 +1,11 @@
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
 #include <gtest/gtest.h>
 #include "my_string.h"
+#include "my_string_search.h"
+#include "my_string_view.h"
 
 TEST(MyStringTest, Constructor) {
   MyString s1;
@@ -46,6 +52,17 @@ TEST(MyStringTest, Comparison) {
   EXPECT_FALSE(s1 == s3);
   EXPECT_TRUE(s1 != s3);
   EXPECT_TRUE(s1 < s3);
+
+  // Embedded nulls take part in the ordering, so unequal strings are always ordered.
+  MyString a("a\0b", 3);
+  MyString c("a\0c", 3);
+  EXPECT_TRUE(a < c);
+  EXPECT_FALSE(c < a);
+  EXPECT_TRUE(MyString("a") < a);
+
+  std::ostringstream out;
+  out << c;
+  EXPECT_EQ(out.str(), std::string("a\0c", 3));
 }
 
 TEST(MyStringTest, IndexAccess) {
@@ -71,4 +88,192 @@ TEST(MyStringTest, MoveSemantics) {
   MyString s2 = std::move(s1);
   EXPECT_STREQ(s2.c_str(), "hello");
   EXPECT_TRUE(s1.empty());  // s1 should be empty after move
-}
\ No newline at end of file
+}
+
+TEST(MyStringTest, InlineAndHeapLayouts) {
+  EXPECT_EQ(sizeof(MyString), 3 * sizeof(size_t));
+  MyString empty;
+  EXPECT_EQ(empty.capacity(), MyString::kInlineCapacity);
+
+  // The longest inline string, whose tag byte is also its null terminator.
+  MyString full("abcdefghijklmnopqrstuvw");
+  EXPECT_EQ(full.length(), MyString::kInlineCapacity);
+  EXPECT_EQ(full.capacity(), MyString::kInlineCapacity);
+  EXPECT_STREQ(full.c_str(), "abcdefghijklmnopqrstuvw");
+
+  MyString grown(full);
+  grown.append("x");
+  EXPECT_EQ(grown.length(), MyString::kInlineCapacity + 1);
+  EXPECT_GT(grown.capacity(), MyString::kInlineCapacity);
+  EXPECT_STREQ(grown.c_str(), "abcdefghijklmnopqrstuvwx");
+
+  MyString copy(grown);
+  EXPECT_TRUE(copy == grown);
+  MyString moved(std::move(grown));
+  EXPECT_STREQ(moved.c_str(), "abcdefghijklmnopqrstuvwx");
+  EXPECT_TRUE(grown.empty());
+  EXPECT_EQ(grown.capacity(), MyString::kInlineCapacity);
+
+  // A short substring of a heap string is inline again.
+  MyString sub = moved.substr(20);
+  EXPECT_STREQ(sub.c_str(), "uvwx");
+  EXPECT_EQ(sub.capacity(), MyString::kInlineCapacity);
+
+  // Clearing keeps the heap buffer, and assignment reuses whichever buffer fits.
+  size_t capacity = moved.capacity();
+  moved.clear();
+  EXPECT_TRUE(moved.empty());
+  EXPECT_STREQ(moved.c_str(), "");
+  EXPECT_EQ(moved.capacity(), capacity);
+  moved = sub;
+  EXPECT_STREQ(moved.c_str(), "uvwx");
+  EXPECT_EQ(moved.capacity(), capacity);
+  sub = copy;
+  EXPECT_STREQ(sub.c_str(), "abcdefghijklmnopqrstuvwx");
+  sub = MyString("short");
+  EXPECT_STREQ(sub.c_str(), "short");
+  EXPECT_EQ(sub.capacity(), MyString::kInlineCapacity);
+
+  // Reserving moves the string to the heap once; appends up to the capacity stay there.
+  sub.reserve(64);
+  EXPECT_EQ(sub.capacity(), 64u);
+  EXPECT_STREQ(sub.c_str(), "short");
+  const char* buffer = sub.c_str();
+  sub.append(MyString("a string that fits into the reserved room"));
+  EXPECT_EQ(sub.c_str(), buffer);
+  sub.reserve(10);
+  EXPECT_EQ(sub.capacity(), 64u);
+}
+
+TEST(MyStringTest, AppendToItself) {
+  MyString s("abcdefghij");
+  s.append(s);
+  EXPECT_STREQ(s.c_str(), "abcdefghijabcdefghij");
+  s.append(s);
+  EXPECT_STREQ(s.c_str(), "abcdefghijabcdefghijabcdefghijabcdefghij");
+  s.append(s.c_str());
+  EXPECT_EQ(s.length(), 80u);
+  EXPECT_EQ(s.find("jabc"), 9u);
+}
+
+TEST(MyStringViewTest, SliceAndFind) {
+  const char buffer[] = "GET /index.html HTTP/1.1";
+  MyStringView request(buffer);
+  EXPECT_EQ(request.length(), 24u);
+
+  size_t space = request.find(" ");
+  MyStringView method = request.substr(0, space);
+  MyStringView rest = request.substr(space + 1);
+  EXPECT_EQ(method, "GET");
+  EXPECT_EQ(rest.data(), buffer + 4);
+  EXPECT_EQ(rest.substr(0, rest.find(" ")), "/index.html");
+  EXPECT_EQ(rest.find("HTTP"), 12u);
+  EXPECT_EQ(rest.find("HTTP", 13), MyStringView::npos);
+  EXPECT_EQ(rest.find(""), 0u);
+  EXPECT_EQ(rest.find("1.1 and more"), MyStringView::npos);
+  EXPECT_TRUE(request.substr(100).empty());
+
+  rest.remove_prefix(12);
+  rest.remove_suffix(4);
+  EXPECT_EQ(rest, "HTTP");
+  EXPECT_EQ(MyStringView(), "");
+}
+
+TEST(MyStringViewTest, CompareAndHash) {
+  MyStringView apple("apple");
+  MyStringView apples("apples");
+  EXPECT_LT(apple.compare(apples), 0);
+  EXPECT_TRUE(apple < apples);
+  EXPECT_TRUE(apples > "apple");
+  EXPECT_TRUE(apple <= "apple");
+  EXPECT_TRUE(apple != apples);
+  EXPECT_TRUE(MyStringView("\xff") > "a");
+
+  MyString owned("apples");
+  EXPECT_TRUE(owned == owned.view());
+  EXPECT_TRUE(apples == owned);
+  EXPECT_EQ(std::hash<MyStringView>()(apples), std::hash<MyString>()(owned));
+
+  std::unordered_set<MyStringView> seen{apple, apples};
+  EXPECT_EQ(seen.count(owned.substr_view(0, 5)), 1u);
+  EXPECT_EQ(seen.count("pear"), 0u);
+}
+
+TEST(MyStringViewTest, MyStringViewsAndOverloads) {
+  MyString s("a string that is too long to be inline");
+  MyStringView word = s.substr_view(2, 6);
+  EXPECT_EQ(word, "string");
+  EXPECT_EQ(word.data(), s.c_str() + 2);
+  EXPECT_TRUE(s.substr_view(100).empty());
+
+  EXPECT_EQ(s.find(word), 2u);
+  EXPECT_EQ(s.find(MyString("inline")), 32u);
+  EXPECT_EQ(s.find("long", 20), 21u);
+
+  MyString copy(word);
+  EXPECT_STREQ(copy.c_str(), "string");
+  copy.append(MyStringView(" theory", 3));
+  EXPECT_STREQ(copy.c_str(), "string th");
+  // Appending a view of the string itself survives the reallocation.
+  s.append(s.substr_view(0, 8));
+  EXPECT_STREQ(s.c_str(), "a string that is too long to be inlinea string");
+}
+
+// Compares every engine the CPU supports with std::string on random text over a small alphabet,
+// so that partial matches are common, for needles on both sides of kLongNeedle.
+TEST(MySearchEngineTest, MatchesNaiveSearch) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> letter(0, 3);
+  for (MySearchLevel level : {MySearchLevel::kScalar, MySearchLevel::kSse2, MySearchLevel::kAvx2}) {
+    const MySearchEngine* engine = MySearchEngineFor(level);
+    if (!engine) continue;
+    SCOPED_TRACE(engine->name);
+    for (int round = 0; round < 300; ++round) {
+      std::string haystack(static_cast<size_t>(round * 3), ' ');
+      for (char& c : haystack) {
+        c = static_cast<char>('a' + letter(rng));
+      }
+      size_t needle_size = static_cast<size_t>(round % 5 == 4 ? MySearchEngine::kLongNeedle - 10 + round % 20 : round % 45);
+      std::string needle;
+      if (needle_size <= haystack.size() && round % 2 == 0) {
+        needle = haystack.substr(haystack.size() - needle_size - (haystack.size() - needle_size) / 3, needle_size);
+      } else {
+        for (size_t i = 0; i < needle_size; ++i) {
+          needle += static_cast<char>('a' + letter(rng));
+        }
+      }
+      size_t expected_count = 0;
+      for (size_t pos = needle.empty() ? std::string::npos : haystack.find(needle); pos != std::string::npos;
+           pos = haystack.find(needle, pos + needle.size())) {
+        ++expected_count;
+      }
+      EXPECT_EQ(engine->find(haystack.data(), haystack.size(), needle.data(), needle.size()), haystack.find(needle));
+      EXPECT_EQ(engine->count(haystack.data(), haystack.size(), needle.data(), needle.size()), expected_count);
+      std::string set = needle.substr(0, std::min<size_t>(needle.size(), static_cast<size_t>(round % 20)));
+      EXPECT_EQ(engine->find_first_of(haystack.data(), haystack.size(), set.data(), set.size()),
+                haystack.find_first_of(set));
+    }
+    EXPECT_EQ(engine->find_first_of("abcdefghijklmnopqrstuvwxyz", 26, "zyx0123456789!@#$%", 18), 23u);
+  }
+  EXPECT_EQ(MySearchEngineFor(MySearchLevel::kScalar)->level, MySearchLevel::kScalar);
+  EXPECT_EQ(MySearchEngineFor(MySearchEngineBest().level), &MySearchEngineBest());
+}
+
+TEST(MyStringTest, SearchPastEmbeddedNulls) {
+  const char bytes[] = "key\0value\0key=value\0";
+  MyString s(bytes, sizeof(bytes) - 1);
+  EXPECT_EQ(s.length(), 20u);
+  EXPECT_EQ(s.find("value"), 4u);
+  EXPECT_EQ(s.find(MyStringView("\0key", 4)), 9u);
+  EXPECT_EQ(s.rfind("value"), 14u);
+  EXPECT_EQ(s.rfind("value", 13), 4u);
+  EXPECT_EQ(s.rfind("value", 3), MyString::npos);
+  EXPECT_EQ(s.rfind(""), 20u);
+  EXPECT_EQ(s.find_first_of("=y"), 2u);
+  EXPECT_EQ(s.find_first_of("=", 3), 13u);
+  EXPECT_EQ(s.find_first_of("#"), MyString::npos);
+  EXPECT_EQ(s.count(MyStringView("\0", 1)), 3u);
+  EXPECT_EQ(s.count("key"), 2u);
+  EXPECT_EQ(MyString("aaaa").count("aa"), 2u);
+  EXPECT_EQ(s.count(""), 0u);
+}
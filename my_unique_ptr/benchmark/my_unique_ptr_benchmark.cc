@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "my_async_deleter.h"
+#include "my_unique_ptr.h"
+
+namespace {
+
+// A per-request scratch buffer of state.range(0) bytes that is filled as soon as it is allocated,
+// the case where zeroing it first is wasted work. Buffers this large are served by fresh mmap
+// pages, so every variant also pays the page faults of the first write.
+template<typename MakeBuffer>
+void RunScratchBuffer(benchmark::State& state, MakeBuffer make) {
+  const size_t size = static_cast<size_t>(std::max<int64_t>(state.range(0), 0));
+  for (auto _ : state) {
+    auto buffer = make(size);
+    std::memset(&buffer[0], 0xab, size);
+    benchmark::DoNotOptimize(&buffer[0]);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Value-initializes, so the buffer is written twice: zeroed, then filled.
+void BM_MakeMyUniqueArray(benchmark::State& state) {
+  RunScratchBuffer(state, [](size_t size) { return MakeMyUnique<char[]>(size); });
+}
+
+// Default-initializes, so the fill is the only pass over the buffer.
+void BM_MakeMyUniqueForOverwriteArray(benchmark::State& state) {
+  RunScratchBuffer(state, [](size_t size) { return MakeMyUniqueForOverwrite<char[]>(size); });
+}
+
+void BM_StdMakeUniqueArray(benchmark::State& state) {
+  RunScratchBuffer(state, [](size_t size) { return std::make_unique<char[]>(size); });
+}
+
+constexpr int64_t kScratchBytes = 64 << 20;
+
+BENCHMARK(BM_MakeMyUniqueArray)->Arg(kScratchBytes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MakeMyUniqueForOverwriteArray)->Arg(kScratchBytes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdMakeUniqueArray)->Arg(kScratchBytes)->Unit(benchmark::kMillisecond);
+
+// A 1 GB structure made of blocks of state.range(0) bytes, all written, standing in for a large
+// index that is swapped out. Each iteration builds one untimed, then times only the caller's
+// reset(). Large blocks are served by mmap, so freeing them unmaps; small ones go back to malloc.
+struct Index {
+  std::vector<MyUniquePtr<char[]>> blocks;
+};
+
+constexpr size_t kIndexBytes = size_t{1} << 30;
+
+template<typename Deleter>
+void BM_FreeIndex(benchmark::State& state) {
+  const size_t block_size = static_cast<size_t>(std::max<int64_t>(state.range(0), 1));
+  std::chrono::nanoseconds background{0};
+  for (auto _ : state) {
+    state.PauseTiming();
+    MyUniquePtr<Index, Deleter> index(new Index());
+    index->blocks.reserve(kIndexBytes / block_size);
+    for (size_t i = 0; i < kIndexBytes / block_size; ++i) {
+      index->blocks.push_back(MakeMyUniqueForOverwrite<char[]>(block_size));
+      std::memset(index->blocks.back().get(), 0xab, block_size);
+    }
+    state.ResumeTiming();
+
+    index.reset();
+
+    state.PauseTiming();
+    // Waits out the background work so that it does not overlap the next build.
+    auto start = std::chrono::steady_clock::now();
+    MyReclaimer::instance().flush();
+    background += std::chrono::steady_clock::now() - start;
+    state.ResumeTiming();
+  }
+  state.counters["flush_ms"] = benchmark::Counter(
+      std::chrono::duration<double, std::milli>(background).count() / static_cast<double>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(BM_FreeIndex, MyDefaultDelete<Index>)
+    ->Arg(1 << 20)->Arg(4 << 10)->Iterations(5)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_FreeIndex, MyAsyncDeleter<Index>)
+    ->Arg(1 << 20)->Arg(4 << 10)->Iterations(5)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <type_traits>
+#include "my_reclaimer.h"
+#include "my_unique_ptr.h"
+
+/**
+ * @brief A deleter for MyUniquePtr that hands the object to a MyReclaimer instead of destroying
+ * it on the calling thread.
+ *
+ * Use it for objects whose destruction is expensive, such as multi-gigabyte indexes, when they
+ * are released on latency-critical threads: `MyUniquePtr<Index, MyAsyncDeleter<Index>>`.
+ *
+ * A default-constructed deleter uses MyReclaimer::instance(), which blocks the releasing thread
+ * while its queue is full. Pass a reclaimer of your own to choose its capacity and backpressure,
+ * or to keep these objects from queueing behind others. The deleter holds a pointer to the
+ * reclaimer, which must outlive every object it deletes.
+ *
+ * @tparam T The type of the object to delete.
+ */
+template<typename T>
+class MyAsyncDeleter {
+public:
+  /**
+   * @brief Creates a deleter for the shared reclaimer.
+   */
+  MyAsyncDeleter() noexcept = default;
+
+  /**
+   * @brief Creates a deleter that hands objects to reclaimer.
+   */
+  explicit MyAsyncDeleter(MyReclaimer& reclaimer) noexcept : reclaimer_(&reclaimer) {}
+
+  /**
+   * @brief Allows a deleter for a derived type to convert to one for its base.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  MyAsyncDeleter(const MyAsyncDeleter<U>& other) noexcept : reclaimer_(other.reclaimer_) {}
+
+  void operator()(T* ptr) const noexcept {
+    static_assert(sizeof(T) > 0, "cannot delete a pointer to an incomplete type");
+    // The shared reclaimer is looked up here rather than stored, so that empty pointers do not
+    // start its thread.
+    MyReclaimer& reclaimer = reclaimer_ ? *reclaimer_ : MyReclaimer::instance();
+    reclaimer.retire(const_cast<void*>(static_cast<const volatile void*>(ptr)),
+                     [](void* object) { delete static_cast<T*>(object); });
+  }
+
+private:
+  template<typename U>
+  friend class MyAsyncDeleter;
+
+  MyReclaimer* reclaimer_ = nullptr;  ///< Null for MyReclaimer::instance().
+};
+
+/**
+ * @brief A deleter for MyUniquePtr<T[]> that hands the array to a MyReclaimer, like
+ * MyAsyncDeleter<T>.
+ */
+template<typename T>
+class MyAsyncDeleter<T[]> {
+public:
+  /**
+   * @brief Creates a deleter for the shared reclaimer.
+   */
+  MyAsyncDeleter() noexcept = default;
+
+  /**
+   * @brief Creates a deleter that hands arrays to reclaimer.
+   */
+  explicit MyAsyncDeleter(MyReclaimer& reclaimer) noexcept : reclaimer_(&reclaimer) {}
+
+  void operator()(T* ptr) const noexcept {
+    static_assert(sizeof(T) > 0, "cannot delete a pointer to an incomplete type");
+    MyReclaimer& reclaimer = reclaimer_ ? *reclaimer_ : MyReclaimer::instance();
+    reclaimer.retire(const_cast<void*>(static_cast<const volatile void*>(ptr)),
+                     [](void* object) { delete[] static_cast<T*>(object); });
+  }
+
+private:
+  MyReclaimer* reclaimer_ = nullptr;  ///< Null for MyReclaimer::instance().
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "my_unique_ptr.h"
+
+/**
+ * @brief A MyUniquePtr that keeps a few flag bits in the low bits of the owned pointer.
+ *
+ * An object aligned to 2^Bits bytes has an address whose lowest Bits bits are always zero, so
+ * they can hold a tag at no cost in space: a node with a child pointer and a flag byte shrinks by
+ * the padding after the flag. The pointer and the tag are independent: get() masks the tag off,
+ * reset() and release() leave it alone, and moves carry it along, leaving the moved-from pointer
+ * empty with a zero tag.
+ *
+ * Ownership works exactly as in MyUniquePtr, including custom deleters, which are stored with
+ * [[no_unique_address]].
+ *
+ * @tparam T The type of the object managed by this pointer; alignof(T) must be at least 2^Bits.
+ * @tparam Bits The number of tag bits.
+ * @tparam Deleter A callable invoked with the untagged pointer to release the object.
+ */
+template<typename T, unsigned Bits, typename Deleter = MyDefaultDelete<T>>
+class MyTaggedUniquePtr {
+  static_assert(Bits > 0, "a tagged pointer needs at least one tag bit");
+
+public:
+  /**
+   * @brief The mask of the tag bits; tags range from 0 to kTagMask.
+   */
+  static constexpr uintptr_t kTagMask = (uintptr_t{1} << Bits) - 1;
+
+  /**
+   * @brief Like MyUniquePtr, a pointer and a deleter without self-references.
+   */
+  using is_trivially_relocatable = std::is_trivially_copyable<Deleter>;
+
+  /**
+   * @brief Constructs a MyTaggedUniquePtr managing ptr.
+   *
+   * @param ptr Pointer to the object to be managed (can be nullptr).
+   * @param tag The initial tag.
+   */
+  explicit MyTaggedUniquePtr(T* ptr = nullptr, uintptr_t tag = 0) noexcept
+      : bits_(reinterpret_cast<uintptr_t>(ptr) | (tag & kTagMask)), deleter_() {}
+
+  /**
+   * @brief Constructs a MyTaggedUniquePtr managing ptr with the given deleter.
+   */
+  MyTaggedUniquePtr(T* ptr, uintptr_t tag, Deleter deleter) noexcept
+      : bits_(reinterpret_cast<uintptr_t>(ptr) | (tag & kTagMask)), deleter_(std::move(deleter)) {}
+
+  MyTaggedUniquePtr(const MyTaggedUniquePtr&) = delete;
+  MyTaggedUniquePtr& operator=(const MyTaggedUniquePtr&) = delete;
+
+  /**
+   * @brief Move constructor. Transfers the object, the tag and the deleter.
+   */
+  MyTaggedUniquePtr(MyTaggedUniquePtr&& other) noexcept
+      : bits_(std::exchange(other.bits_, 0)), deleter_(std::move(other.deleter_)) {}
+
+  /**
+   * @brief Move assignment operator. Releases the current object, then transfers the object, the
+   * tag and the deleter.
+   */
+  MyTaggedUniquePtr& operator=(MyTaggedUniquePtr&& other) noexcept {
+    if (this != &other) {
+      reset();
+      bits_ = std::exchange(other.bits_, 0);
+      deleter_ = std::move(other.deleter_);
+    }
+    return *this;
+  }
+
+  ~MyTaggedUniquePtr() {
+    // Checked here rather than at class scope, where T may still be incomplete, as in a node
+    // type with tagged pointers to its children.
+    static_assert(alignof(T) >= (size_t{1} << Bits), "T is not aligned enough to spare that many low bits");
+    if (T* ptr = get()) {
+      deleter_(ptr);
+    }
+  }
+
+  T& operator*() const noexcept {
+    return *get();
+  }
+
+  T* operator->() const noexcept {
+    return get();
+  }
+
+  /**
+   * @brief Returns the managed pointer without the tag.
+   */
+  T* get() const noexcept {
+    return reinterpret_cast<T*>(bits_ & ~kTagMask);
+  }
+
+  /**
+   * @brief Returns the tag.
+   */
+  uintptr_t tag() const noexcept {
+    return bits_ & kTagMask;
+  }
+
+  /**
+   * @brief Replaces the tag; the managed object is unaffected.
+   *
+   * @param tag The new tag; bits above kTagMask are ignored.
+   */
+  void set_tag(uintptr_t tag) noexcept {
+    bits_ = (bits_ & ~kTagMask) | (tag & kTagMask);
+  }
+
+  Deleter& get_deleter() noexcept {
+    return deleter_;
+  }
+
+  const Deleter& get_deleter() const noexcept {
+    return deleter_;
+  }
+
+  explicit operator bool() const noexcept {
+    return get() != nullptr;
+  }
+
+  /**
+   * @brief Releases ownership of the managed object, keeping the tag.
+   *
+   * @return The untagged pointer to the object.
+   */
+  T* release() noexcept {
+    T* ptr = get();
+    bits_ &= kTagMask;
+    return ptr;
+  }
+
+  /**
+   * @brief Replaces the managed object, keeping the tag.
+   *
+   * @param ptr The new pointer to manage.
+   */
+  void reset(T* ptr = nullptr) noexcept {
+    T* old = get();
+    if (old != ptr) {
+      bits_ = reinterpret_cast<uintptr_t>(ptr) | tag();
+      if (old) {
+        deleter_(old);
+      }
+    }
+  }
+
+private:
+  uintptr_t bits_;                         ///< The pointer in the high bits, the tag in the low bits.
+  [[no_unique_address]] Deleter deleter_;  ///< Releases the managed object.
+};
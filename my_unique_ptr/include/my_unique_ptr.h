@@ -1,27 +1,144 @@
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
 #include <utility>
 
+/**
+ * @brief The default deleter of MyUniquePtr, which releases the object with `delete`.
+ *
+ * Stateless, so it takes no space inside MyUniquePtr.
+ *
+ * @tparam T The type of the object to delete.
+ */
+template<typename T>
+struct MyDefaultDelete {
+  MyDefaultDelete() noexcept = default;
+
+  /**
+   * @brief Allows a deleter for a derived type to convert to one for its base.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  MyDefaultDelete(const MyDefaultDelete<U>&) noexcept {}
+
+  void operator()(T* ptr) const noexcept {
+    static_assert(sizeof(T) > 0, "cannot delete a pointer to an incomplete type");
+    delete ptr;
+  }
+};
+
+/**
+ * @brief The default deleter of MyUniquePtr<T[]>, which releases the array with `delete[]`.
+ *
+ * @tparam T The element type of the array to delete.
+ */
+template<typename T>
+struct MyDefaultDelete<T[]> {
+  MyDefaultDelete() noexcept = default;
+
+  /**
+   * @brief Allows a deleter for an array of U to convert to one for an array of T, e.g. of
+   * const U. Arrays of a derived type do not convert: the elements would be indexed with the
+   * wrong size.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+  MyDefaultDelete(const MyDefaultDelete<U[]>&) noexcept {}
+
+  void operator()(T* ptr) const noexcept {
+    static_assert(sizeof(T) > 0, "cannot delete a pointer to an incomplete type");
+    delete[] ptr;
+  }
+};
+
+/**
+ * @brief The handle type a MyUniquePtr stores: Deleter::pointer if the deleter names one, a
+ * pointer to T or to the first element of T[] otherwise.
+ *
+ * A deleter may name a handle that is not a raw pointer, as long as it behaves like one: a
+ * value-initialized handle means empty, and handles can be compared with `!=`. A plain int
+ * file descriptor does not qualify, since 0 is a valid descriptor; wrap it in a type whose
+ * empty value is -1.
+ */
+template<typename T, typename Deleter, typename = void>
+struct MyUniquePointerType {
+  using type = std::remove_extent_t<T>*;
+};
+
+template<typename T, typename Deleter>
+struct MyUniquePointerType<T, Deleter, std::void_t<typename std::remove_reference_t<Deleter>::pointer>> {
+  using type = typename std::remove_reference_t<Deleter>::pointer;
+};
+
 /**
  * @brief A custom unique pointer implementation that manages exclusive ownership of a dynamically allocated object.
  *
  * MyUniquePtr is a simple implementation of a unique pointer, ensuring that only one instance can own the
  * resource at a time. It supports move semantics but disallows copy semantics. When the unique pointer is destroyed,
- * the managed object is deleted.
+ * the managed object is released by the Deleter.
  *
- * @tparam T The type of the object managed by this pointer.
+ * The deleter is stored with [[no_unique_address]], so a stateless deleter such as the default
+ * one or an empty lambda adds nothing: MyUniquePtr<T> is exactly as big as a T*. Stateful
+ * deleters, e.g. a pool to return objects to, add their own size.
+ *
+ * MyUniquePtr<T[]> owns an array allocated with `new[]`, releases it with `delete[]` and offers
+ * operator[]. Prefer MakeMyUnique to create the object or array together with its owner.
+ *
+ * @tparam T The type of the object managed by this pointer, or U[] for an array of U.
+ * @tparam Deleter A callable invoked with the stored pointer to release the object.
  */
-template<typename T>
+template<typename T, typename Deleter = MyDefaultDelete<T>>
 class MyUniquePtr {
 public:
+  /**
+   * @brief The stored handle type, T* unless the Deleter defines a pointer type.
+   */
+  using pointer = typename MyUniquePointerType<T, Deleter>::type;
+
+  /**
+   * @brief The type of the object pointed to; the element type if T is an array.
+   */
+  using element_type = std::remove_extent_t<T>;
+
+  /**
+   * @brief The type of the deleter.
+   */
+  using deleter_type = Deleter;
+
+  /**
+   * @brief Relocatable when the handle and deleter are trivially copyable, as raw pointers and
+   * stateless deleters are.
+   */
+  using is_trivially_relocatable =
+      std::bool_constant<std::is_trivially_copyable_v<pointer> && std::is_trivially_copyable_v<Deleter>>;
+
   /**
    * @brief Constructs a new MyUniquePtr managing a raw pointer.
    *
-   * Initializes a new MyUniquePtr to manage the given raw pointer.
+   * Initializes a new MyUniquePtr to manage the given raw pointer, with a default-constructed deleter.
+   *
+   * @param ptr Pointer to the object to be managed (can be nullptr).
+   */
+  explicit MyUniquePtr(pointer ptr = pointer()) noexcept : ptr_(ptr), deleter_() {}
+
+  /**
+   * @brief Constructs a new MyUniquePtr managing a raw pointer with the given deleter.
    *
    * @param ptr Pointer to the object to be managed (can be nullptr).
+   * @param deleter The deleter that will release ptr.
    */
-  explicit MyUniquePtr(T* ptr = nullptr) : ptr_(ptr) {}
+  MyUniquePtr(pointer ptr, Deleter deleter) noexcept : ptr_(ptr), deleter_(std::move(deleter)) {}
+
+  /**
+   * @brief MyUniquePtr<T[]> does not take a pointer to an array of a type derived from T:
+   * indexing it and deleting it would use the wrong element size.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_array_v<T> && std::is_convertible_v<U*, pointer> &&
+                                       !std::is_convertible_v<U(*)[], element_type(*)[]>>>
+  explicit MyUniquePtr(U* ptr) = delete;
+
+  template<typename U, typename = std::enable_if_t<std::is_array_v<T> && std::is_convertible_v<U*, pointer> &&
+                                       !std::is_convertible_v<U(*)[], element_type(*)[]>>>
+  MyUniquePtr(U* ptr, Deleter deleter) = delete;
 
   // Forbid copy constructor
   MyUniquePtr(const MyUniquePtr&) = delete;
@@ -32,28 +149,41 @@ public:
   /**
    * @brief Move constructor.
    *
-   * Transfers ownership from another MyUniquePtr to this one.
+   * Transfers ownership, and the deleter, from another MyUniquePtr to this one.
    *
    * @param other The MyUniquePtr instance to move from.
    */
-  MyUniquePtr(MyUniquePtr&& other) noexcept : ptr_(other.ptr_) {
-    other.ptr_ = nullptr;
-  }
+  MyUniquePtr(MyUniquePtr&& other) noexcept : ptr_(other.release()), deleter_(std::move(other.deleter_)) {}
+
+  /**
+   * @brief Converting move constructor.
+   *
+   * Transfers ownership from a MyUniquePtr to a derived type, converting its deleter. An array
+   * only converts to an array of the same, possibly more cv-qualified, element type.
+   *
+   * @tparam U A type whose pointer converts implicitly to T*.
+   * @tparam E A deleter type that converts to Deleter.
+   * @param other The MyUniquePtr instance to move from.
+   */
+  template<typename U, typename E,
+           typename = std::enable_if_t<std::is_convertible_v<U*, T*> &&
+                                       std::is_convertible_v<typename MyUniquePtr<U, E>::pointer, pointer> &&
+                                       std::is_convertible_v<E, Deleter>>>
+  MyUniquePtr(MyUniquePtr<U, E>&& other) noexcept
+      : ptr_(other.release()), deleter_(std::move(other.get_deleter())) {}
 
   /**
    * @brief Move assignment operator.
    *
-   * Transfers ownership from another MyUniquePtr to this one.
+   * Releases the current object, then transfers ownership and the deleter from another MyUniquePtr.
    *
    * @param other The MyUniquePtr instance to move from.
    * @return A reference to the updated MyUniquePtr.
    */
   MyUniquePtr& operator=(MyUniquePtr&& other) noexcept {
     if (this != &other) {
-      // delete the current managed object
-      delete ptr_;
-      ptr_ = other.ptr_;
-      other.ptr_ = nullptr;
+      reset(other.release());
+      deleter_ = std::move(other.deleter_);
     }
     return *this;
   }
@@ -61,11 +191,11 @@ public:
   /**
    * @brief Destructor.
    *
-   * Deletes the managed object.
+   * Releases the managed object with the deleter.
    */
   ~MyUniquePtr() {
-    if (ptr_) {
-      delete ptr_;
+    if (ptr_ != pointer()) {
+      deleter_(ptr_);
     }
   }
 
@@ -76,7 +206,7 @@ public:
    *
    * @return A reference to the managed object.
    */
-  T& operator*() const {
+  element_type& operator*() const {
     return *ptr_;
   }
 
@@ -87,26 +217,51 @@ public:
    *
    * @return A pointer to the managed object.
    */
-  T* operator->() const {
+  pointer operator->() const {
     return ptr_;
   }
 
+  /**
+   * @brief Subscript operator for MyUniquePtr<T[]>.
+   *
+   * @param index The index of the element; it must be within the managed array.
+   * @return A reference to the element.
+   */
+  element_type& operator[](std::ptrdiff_t index) const {
+    static_assert(std::is_array_v<T>, "operator[] requires MyUniquePtr<T[]>");
+    return ptr_[index];
+  }
+
   /**
    * @brief Returns the managed pointer.
    *
    * @return The raw pointer to the managed object.
    */
-  T* get() const {
+  pointer get() const {
     return ptr_;
   }
-  
+
+  /**
+   * @brief Returns the deleter that will release the managed object.
+   */
+  Deleter& get_deleter() noexcept {
+    return deleter_;
+  }
+
+  /**
+   * @brief Returns the deleter that will release the managed object.
+   */
+  const Deleter& get_deleter() const noexcept {
+    return deleter_;
+  }
+
   /**
    * @brief Checks if the managed object is non-null.
    *
    * @return true if the managed object is non-null, false otherwise.
    */
   explicit operator bool() const noexcept {
-    return ptr_ != nullptr;
+    return ptr_ != pointer();
   }
 
   /**
@@ -116,26 +271,93 @@ public:
    *
    * @return The raw pointer to the managed object.
    */
-  T* release() {
-    T* temp = ptr_;
-    ptr_ = nullptr;
+  pointer release() {
+    pointer temp = ptr_;
+    ptr_ = pointer();
     return temp;
   }
 
   /**
    * @brief Replaces the managed object.
    *
-   * Deletes the currently managed object and takes ownership of ptr.
+   * Releases the currently managed object with the deleter and takes ownership of ptr.
    *
    * @param ptr The new pointer to manage.
    */
-  void reset(T* ptr = nullptr) {
+  void reset(pointer ptr = pointer()) {
     if (ptr_ != ptr) {
-      delete ptr_;
+      pointer old = ptr_;
       ptr_ = ptr;
+      if (old != pointer()) {
+        deleter_(old);
+      }
     }
   }
 
+  /**
+   * @brief Like the constructor, reset() does not take an array of a type derived from T.
+   */
+  template<typename U, typename = std::enable_if_t<std::is_array_v<T> && std::is_convertible_v<U*, pointer> &&
+                                       !std::is_convertible_v<U(*)[], element_type(*)[]>>>
+  void reset(U* ptr) = delete;
+
 private:
-  T* ptr_;   ///< Pointer to the managed object.
-}; 
\ No newline at end of file
+  pointer ptr_;                            ///< Pointer to the managed object.
+  [[no_unique_address]] Deleter deleter_;  ///< Releases the managed object.
+};
+
+/**
+ * @brief Creates an object and the MyUniquePtr that owns it.
+ *
+ * @tparam T The type of the object to create.
+ * @param args Arguments forwarded to the constructor of T.
+ * @return A MyUniquePtr owning the new object.
+ */
+template<typename T, typename... Args, typename = std::enable_if_t<!std::is_array_v<T>>>
+MyUniquePtr<T> MakeMyUnique(Args&&... args) {
+  return MyUniquePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Creates an array of size value-initialized elements and the MyUniquePtr<T[]> that owns
+ * it. Elements of scalar type are zeroed, which for a large buffer costs a pass over its memory;
+ * use MakeMyUniqueForOverwrite if every element is written before it is read.
+ *
+ * @tparam T U[], where U is the element type.
+ * @param size The number of elements.
+ * @return A MyUniquePtr owning the new array.
+ */
+template<typename T, typename = std::enable_if_t<std::is_array_v<T> && std::extent_v<T> == 0>>
+MyUniquePtr<T> MakeMyUnique(size_t size) {
+  return MyUniquePtr<T>(new std::remove_extent_t<T>[size]());
+}
+
+/**
+ * @brief Creates a default-initialized object and the MyUniquePtr that owns it.
+ *
+ * For a type without a user-provided constructor, the members are left indeterminate, so they
+ * must be written before they are read.
+ *
+ * @tparam T The type of the object to create.
+ * @return A MyUniquePtr owning the new object.
+ */
+template<typename T, typename = std::enable_if_t<!std::is_array_v<T>>>
+MyUniquePtr<T> MakeMyUniqueForOverwrite() {
+  return MyUniquePtr<T>(new T);
+}
+
+/**
+ * @brief Creates an array of size default-initialized elements and the MyUniquePtr<T[]> that
+ * owns it.
+ *
+ * Scalar elements are left indeterminate rather than zeroed, so a scratch buffer that is filled
+ * right away is not written twice; the memory is only touched by whoever fills it.
+ *
+ * @tparam T U[], where U is the element type.
+ * @param size The number of elements.
+ * @return A MyUniquePtr owning the new array.
+ */
+template<typename T, typename = std::enable_if_t<std::is_array_v<T> && std::extent_v<T> == 0>>
+MyUniquePtr<T> MakeMyUniqueForOverwrite(size_t size) {
+  return MyUniquePtr<T>(new std::remove_extent_t<T>[size]);
+}
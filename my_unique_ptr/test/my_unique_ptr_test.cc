@@ -1,4 +1,11 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
+#include "my_async_deleter.h"
+#include "my_tagged_unique_ptr.h"
 #include "my_unique_ptr.h"
 
 // Define a test class to verify object destruction.
@@ -66,4 +73,275 @@ TEST(MyUniquePtrTest, ObjectDestruction) {
     EXPECT_EQ(TestObject::instance_count, 1);
   }
   EXPECT_EQ(TestObject::instance_count, 0);
-} 
\ No newline at end of file
+}
+
+// A deleter with state: it counts how many objects it released.
+struct CountingDeleter {
+  void operator()(int* ptr) const {
+    ++*released;
+    delete ptr;
+  }
+  int* released;
+};
+
+// A file descriptor that behaves like a nullable pointer: -1, not 0, means none.
+class Fd {
+ public:
+  Fd() = default;
+  Fd(std::nullptr_t) {}
+  explicit Fd(int fd) : fd_(fd) {}
+
+  int get() const { return fd_; }
+
+  friend bool operator==(Fd lhs, Fd rhs) { return lhs.fd_ == rhs.fd_; }
+  friend bool operator!=(Fd lhs, Fd rhs) { return lhs.fd_ != rhs.fd_; }
+
+ private:
+  int fd_ = -1;
+};
+
+// A deleter for a handle that is not a pointer at all.
+struct FdCloser {
+  using pointer = Fd;
+  void operator()(Fd fd) const { closed.push_back(fd.get()); }
+  static inline std::vector<int> closed;
+};
+
+TEST(MyUniquePtrTest, StatelessDeletersTakeNoSpace) {
+  auto free_deleter = [](int* ptr) { delete ptr; };
+  static_assert(sizeof(MyUniquePtr<int>) == sizeof(int*));
+  static_assert(sizeof(MyUniquePtr<TestObject>) == sizeof(TestObject*));
+  static_assert(sizeof(MyUniquePtr<int, decltype(free_deleter)>) == sizeof(int*));
+  static_assert(sizeof(MyUniquePtr<int, FdCloser>) == sizeof(Fd));
+  static_assert(sizeof(MyUniquePtr<int, CountingDeleter>) == 2 * sizeof(int*));
+}
+
+TEST(MyUniquePtrTest, StatefulDeleter) {
+  int released = 0;
+  {
+    MyUniquePtr<int, CountingDeleter> ptr(new int(1), CountingDeleter{&released});
+    EXPECT_EQ(ptr.get_deleter().released, &released);
+    ptr.reset(new int(2));
+    EXPECT_EQ(released, 1);
+    MyUniquePtr<int, CountingDeleter> moved(std::move(ptr));
+    EXPECT_EQ(moved.get_deleter().released, &released);
+    EXPECT_EQ(released, 1);
+  }
+  EXPECT_EQ(released, 2);
+}
+
+TEST(MyUniquePtrTest, FileHandle) {
+  std::FILE* file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  MyUniquePtr<std::FILE, int (*)(std::FILE*)> ptr(file, &std::fclose);
+  EXPECT_EQ(ptr.get_deleter(), &std::fclose);
+  EXPECT_GT(std::fputs("hello", ptr.get()), 0);
+}
+
+TEST(MyUniquePtrTest, NonPointerHandle) {
+  FdCloser::closed.clear();
+  {
+    MyUniquePtr<int, FdCloser> fd(Fd(7));
+    EXPECT_TRUE(fd);
+    EXPECT_EQ(fd.get().get(), 7);
+    // Descriptor 0 is a real handle, so it is owned and closed like any other.
+    MyUniquePtr<int, FdCloser> stdin_fd(Fd(0));
+    EXPECT_TRUE(stdin_fd);
+    MyUniquePtr<int, FdCloser> none;
+    EXPECT_FALSE(none);
+    EXPECT_EQ(none.get().get(), -1);
+    MyUniquePtr<int, FdCloser> invalid(Fd(-1));
+    EXPECT_FALSE(invalid);
+  }
+  EXPECT_EQ(FdCloser::closed, (std::vector<int>{0, 7}));
+}
+
+class Shape {
+ public:
+  virtual ~Shape() = default;
+};
+
+class Circle : public Shape {
+ public:
+  Circle() { ++TestObject::instance_count; }
+  ~Circle() override { --TestObject::instance_count; }
+};
+
+TEST(MyUniquePtrTest, ConvertingMove) {
+  {
+    MyUniquePtr<Circle> circle(new Circle());
+    MyUniquePtr<Shape> shape(std::move(circle));
+    EXPECT_EQ(circle.get(), nullptr);
+    EXPECT_EQ(TestObject::instance_count, 1);
+  }
+  EXPECT_EQ(TestObject::instance_count, 0);
+}
+
+TEST(MyUniquePtrTest, ArrayPointer) {
+  {
+    MyUniquePtr<TestObject[]> objects(new TestObject[3]);
+    EXPECT_EQ(TestObject::instance_count, 3);
+    objects.reset(new TestObject[2]);
+    EXPECT_EQ(TestObject::instance_count, 2);
+  }
+  EXPECT_EQ(TestObject::instance_count, 0);
+
+  MyUniquePtr<int[]> values(new int[4]{1, 2, 3, 4});
+  values[2] = 30;
+  EXPECT_EQ(values[0], 1);
+  EXPECT_EQ(values[2], 30);
+  MyUniquePtr<const int[]> readonly(std::move(values));
+  EXPECT_EQ(readonly[3], 4);
+  static_assert(!std::is_constructible_v<MyUniquePtr<Shape[]>, MyUniquePtr<Circle[]>&&>,
+                "arrays of a derived type must not convert to arrays of its base");
+  static_assert(!std::is_constructible_v<MyUniquePtr<Shape[]>, Circle*>,
+                "a pointer to an array of a derived type must not be adopted as one of its base");
+  static_assert(!std::is_constructible_v<MyUniquePtr<Shape[]>, Circle*, MyDefaultDelete<Shape[]>>,
+                "a pointer to an array of a derived type must not be adopted as one of its base");
+  static_assert(std::is_constructible_v<MyUniquePtr<const int[]>, int*>);
+}
+
+TEST(MyUniquePtrTest, MakeMyUnique) {
+  MyUniquePtr<std::vector<int>> object = MakeMyUnique<std::vector<int>>(3, 7);
+  EXPECT_EQ(*object, std::vector<int>(3, 7));
+
+  MyUniquePtr<int[]> zeroed = MakeMyUnique<int[]>(5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(zeroed[i], 0);
+  }
+
+  {
+    MyUniquePtr<TestObject[]> objects = MakeMyUniqueForOverwrite<TestObject[]>(4);
+    EXPECT_EQ(TestObject::instance_count, 4);
+  }
+  EXPECT_EQ(TestObject::instance_count, 0);
+
+  MyUniquePtr<char[]> buffer = MakeMyUniqueForOverwrite<char[]>(16);
+  buffer[15] = 'x';
+  EXPECT_EQ(buffer[15], 'x');
+  MyUniquePtr<int> scalar = MakeMyUniqueForOverwrite<int>();
+  *scalar = 9;
+  EXPECT_EQ(*scalar, 9);
+}
+
+struct alignas(8) TaggedNode {
+  explicit TaggedNode(int value) : value(value) { ++TestObject::instance_count; }
+  ~TaggedNode() { --TestObject::instance_count; }
+  int value;
+};
+
+TEST(MyTaggedUniquePtrTest, TagSharesThePointerWord) {
+  static_assert(sizeof(MyTaggedUniquePtr<TaggedNode, 3>) == sizeof(TaggedNode*));
+  {
+    MyTaggedUniquePtr<TaggedNode, 3> ptr(new TaggedNode(5), 6);
+    EXPECT_EQ(ptr->value, 5);
+    EXPECT_EQ(ptr.tag(), 6u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr.get()) % alignof(TaggedNode), 0u);
+    ptr.set_tag(1);
+    EXPECT_EQ(ptr.tag(), 1u);
+    EXPECT_EQ((*ptr).value, 5);
+    ptr.set_tag(0xff);
+    EXPECT_EQ(ptr.tag(), 7u);
+  }
+  EXPECT_EQ(TestObject::instance_count, 0);
+}
+
+TEST(MyTaggedUniquePtrTest, OwnershipKeepsTheTag) {
+  MyTaggedUniquePtr<TaggedNode, 2> empty;
+  EXPECT_FALSE(empty);
+  empty.set_tag(3);
+  EXPECT_FALSE(empty);
+  EXPECT_EQ(empty.tag(), 3u);
+
+  MyTaggedUniquePtr<TaggedNode, 2> ptr(new TaggedNode(1), 2);
+  ptr.reset(new TaggedNode(2));
+  EXPECT_EQ(ptr->value, 2);
+  EXPECT_EQ(ptr.tag(), 2u);
+  EXPECT_EQ(TestObject::instance_count, 1);
+
+  MyTaggedUniquePtr<TaggedNode, 2> moved(std::move(ptr));
+  EXPECT_FALSE(ptr);
+  EXPECT_EQ(ptr.tag(), 0u);
+  EXPECT_EQ(moved.tag(), 2u);
+
+  TaggedNode* raw = moved.release();
+  EXPECT_FALSE(moved);
+  EXPECT_EQ(moved.tag(), 2u);
+  delete raw;
+  EXPECT_EQ(TestObject::instance_count, 0);
+}
+
+struct CountingNodeDeleter {
+  int* deleted;
+  void operator()(TaggedNode* node) const {
+    ++*deleted;
+    delete node;
+  }
+};
+
+TEST(MyTaggedUniquePtrTest, CustomDeleter) {
+  int deleted = 0;
+  {
+    MyTaggedUniquePtr<TaggedNode, 1, CountingNodeDeleter> ptr(new TaggedNode(1), 1, CountingNodeDeleter{&deleted});
+    MyTaggedUniquePtr<TaggedNode, 1, CountingNodeDeleter> other(nullptr, 0, CountingNodeDeleter{&deleted});
+    other = std::move(ptr);
+    EXPECT_EQ(other.tag(), 1u);
+    EXPECT_EQ(deleted, 0);
+  }
+  EXPECT_EQ(deleted, 1);
+}
+
+// Records the thread that destroyed it, and optionally owns another object released the same way.
+struct AsyncObject {
+  std::atomic<std::thread::id>* destroyed_on;
+  MyUniquePtr<AsyncObject, MyAsyncDeleter<AsyncObject>> child;
+
+  explicit AsyncObject(std::atomic<std::thread::id>* destroyed_on) : destroyed_on(destroyed_on) {}
+  ~AsyncObject() { destroyed_on->store(std::this_thread::get_id()); }
+};
+
+TEST(MyAsyncDeleterTest, DestroysOnTheReclaimerThread) {
+  std::atomic<std::thread::id> parent_thread;
+  std::atomic<std::thread::id> child_thread;
+  size_t reclaimed = MyReclaimer::instance().stats().reclaimed;
+  MyUniquePtr<AsyncObject, MyAsyncDeleter<AsyncObject>> ptr(new AsyncObject(&parent_thread));
+  ptr->child.reset(new AsyncObject(&child_thread));
+
+  ptr.reset();
+  MyReclaimer::instance().flush();
+  EXPECT_NE(parent_thread.load(), std::this_thread::get_id());
+  // The child was released by a destructor the reclaimer ran, so it went into the next batch.
+  EXPECT_EQ(child_thread.load(), parent_thread.load());
+  EXPECT_EQ(MyReclaimer::instance().stats().reclaimed, reclaimed + 2);
+
+  std::atomic<std::thread::id> array_thread;
+  MyUniquePtr<AsyncObject[], MyAsyncDeleter<AsyncObject[]>> array(
+      new AsyncObject[2]{AsyncObject(&array_thread), AsyncObject(&array_thread)});
+  array.reset();
+  MyReclaimer::instance().flush();
+  EXPECT_EQ(array_thread.load(), parent_thread.load());
+}
+
+TEST(MyAsyncDeleterTest, UsesTheGivenReclaimer) {
+  MyReclaimer reclaimer(8, MyBackpressure::kDestroyInline);
+  size_t shared_reclaimed = MyReclaimer::instance().stats().reclaimed;
+  std::atomic<std::thread::id> destroyed_on;
+  MyUniquePtr<AsyncObject, MyAsyncDeleter<AsyncObject>> ptr(
+      new AsyncObject(&destroyed_on), MyAsyncDeleter<AsyncObject>(reclaimer));
+  // Converting and moving keep the reclaimer.
+  MyUniquePtr<AsyncObject, MyAsyncDeleter<const AsyncObject>> moved(std::move(ptr));
+  moved.reset();
+  reclaimer.flush();
+  EXPECT_NE(destroyed_on.load(), std::thread::id());
+  EXPECT_NE(destroyed_on.load(), std::this_thread::get_id());
+  EXPECT_EQ(reclaimer.stats().reclaimed, 1u);
+  EXPECT_EQ(MyReclaimer::instance().stats().reclaimed, shared_reclaimed);
+
+  std::atomic<std::thread::id> array_thread;
+  MyUniquePtr<AsyncObject[], MyAsyncDeleter<AsyncObject[]>> array(
+      new AsyncObject[1]{AsyncObject(&array_thread)}, MyAsyncDeleter<AsyncObject[]>(reclaimer));
+  array.reset();
+  reclaimer.flush();
+  EXPECT_EQ(array_thread.load(), destroyed_on.load());
+  EXPECT_EQ(reclaimer.stats().reclaimed, 2u);
+}
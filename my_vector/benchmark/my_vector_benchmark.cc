@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "my_string.h"
+#include "my_unique_ptr.h"
+#include "my_vector.h"
+
+namespace {
+
+constexpr int64_t kElements = 10'000'000;
+
+template<typename T>
+T MakeElement(int64_t i);
+
+template<>
+MyUniquePtr<int64_t> MakeElement<MyUniquePtr<int64_t>>(int64_t i) {
+  return MakeMyUnique<int64_t>(i);
+}
+
+template<>
+MyString MakeElement<MyString>(int64_t) {
+  return MyString("a short string");
+}
+
+// Builds the elements up front, then times only appending them to a vector that starts empty and
+// grows as it goes, so the time is spent moving elements between buffers.
+template<typename Vector>
+void BM_Growth(benchmark::State& state) {
+  using T = typename Vector::value_type;
+  std::vector<T> source;
+  for (auto _ : state) {
+    state.PauseTiming();
+    source.clear();
+    source.reserve(static_cast<size_t>(state.range(0)));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      source.push_back(MakeElement<T>(i));
+    }
+    Vector vector;
+    state.ResumeTiming();
+    for (T& element : source) {
+      vector.push_back(std::move(element));
+    }
+    benchmark::DoNotOptimize(vector.data());
+    state.PauseTiming();
+    // Destroying 10M elements is not what we are measuring.
+    { Vector discard(std::move(vector)); }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Erases the first element and appends a new one, so every iteration shifts all the others.
+template<typename Vector>
+void BM_EraseFront(benchmark::State& state) {
+  using T = typename Vector::value_type;
+  Vector vector;
+  vector.reserve(static_cast<size_t>(state.range(0)) + 1);
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    vector.push_back(MakeElement<T>(i));
+  }
+  for (auto _ : state) {
+    vector.erase(vector.begin());
+    vector.push_back(MakeElement<T>(0));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_Growth, std::vector<MyUniquePtr<int64_t>>)->Arg(kElements)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Growth, MyVector<MyUniquePtr<int64_t>>)->Arg(kElements)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Growth, std::vector<MyString>)->Arg(kElements)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Growth, MyVector<MyString>)->Arg(kElements)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_EraseFront, std::vector<MyUniquePtr<int64_t>>)->Arg(kElements)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_EraseFront, MyVector<MyUniquePtr<int64_t>>)->Arg(kElements)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_EraseFront, std::vector<MyString>)->Arg(kElements)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_EraseFront, MyVector<MyString>)->Arg(kElements)->Unit(benchmark::kMillisecond);
+
+}  // namespace
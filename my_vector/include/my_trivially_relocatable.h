@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Tells whether a T can be relocated, that is, moved to a new address with the original
+ * abandoned and not destroyed, by copying its bytes.
+ *
+ * That holds for every trivially copyable type, and for most types that merely own a heap
+ * resource through pointers, such as smart pointers and strings: the move constructor copies the
+ * pointers, and the destructor of the moved-from object does nothing. It does not hold for types
+ * that point into themselves or register their address elsewhere. Containers such as MyVector
+ * use it to move their elements with a single memmove when they grow.
+ *
+ * A type opts in by declaring `using is_trivially_relocatable = std::true_type;` (or any
+ * std::bool_constant) as a public member, which keeps the trait free of dependencies on the types
+ * it describes. Anything else falls back to std::is_trivially_copyable.
+ *
+ * @tparam T The type to check.
+ */
+template<typename T, typename = void>
+struct MyIsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+struct MyIsTriviallyRelocatable<T, std::void_t<typename T::is_trivially_relocatable>>
+    : std::bool_constant<T::is_trivially_relocatable::value> {};
+
+template<typename T>
+inline constexpr bool MyIsTriviallyRelocatableV = MyIsTriviallyRelocatable<T>::value;
+
+/**
+ * @brief Relocates count objects from source to the uninitialized memory at destination, which
+ * may overlap. Afterwards the source objects must be treated as destroyed.
+ *
+ * @tparam T A trivially relocatable type.
+ */
+template<typename T>
+void MyRelocate(T* source, size_t count, T* destination) noexcept {
+  if (count == 0) {
+    return;
+  }
+  static_assert(MyIsTriviallyRelocatableV<T>, "MyRelocate requires a trivially relocatable type");
+  std::memmove(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+}
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "my_trivially_relocatable.h"
+
+/**
+ * @brief A growable array that relocates trivially relocatable elements with memcpy.
+ *
+ * For a T with MyIsTriviallyRelocatable, growing hands the buffer to std::realloc, which can
+ * often extend it in place or remap its pages instead of copying, and insert() and erase() shift
+ * the tail with one memmove. No move constructor, move assignment or destructor runs for elements
+ * that merely change address. Other types are moved one by one, as std::vector does.
+ *
+ * Growth doubles the capacity. Pointers, references and iterators are invalidated by any growth,
+ * and by insert() and erase() from the affected position on.
+ *
+ * @tparam T The element type. Its alignment must not exceed that of std::max_align_t.
+ */
+template<typename T>
+class MyVector {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  /**
+   * @brief The vector itself is three words and nothing points back into it.
+   */
+  using is_trivially_relocatable = std::true_type;
+
+  /**
+   * @brief Constructs an empty vector; nothing is allocated until the first element arrives.
+   */
+  MyVector() noexcept = default;
+
+  /**
+   * @brief Constructs a vector of count value-initialized elements.
+   *
+   * This and the other constructors that fill the vector delegate to the default constructor,
+   * so that if an element constructor throws, the destructor frees what was built so far.
+   */
+  explicit MyVector(size_t count) : MyVector() {
+    reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      emplace_back();
+    }
+  }
+
+  /**
+   * @brief Constructs a vector holding copies of the given elements.
+   */
+  MyVector(std::initializer_list<T> elements) : MyVector() {
+    reserve(elements.size());
+    for (const T& element : elements) {
+      emplace_back(element);
+    }
+  }
+
+  /**
+   * @brief Copy constructor.
+   */
+  MyVector(const MyVector& other) : MyVector() {
+    reserve(other.size_);
+    for (const T& element : other) {
+      emplace_back(element);
+    }
+  }
+
+  /**
+   * @brief Move constructor. Takes over other's buffer; other becomes empty.
+   */
+  MyVector(MyVector&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+
+  /**
+   * @brief Destroys the elements and frees the buffer.
+   */
+  ~MyVector() {
+    clear();
+    std::free(data_);
+  }
+
+  /**
+   * @brief Copy assignment operator.
+   */
+  MyVector& operator=(const MyVector& other) {
+    if (this != &other) {
+      MyVector(other).swap(*this);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   */
+  MyVector& operator=(MyVector&& other) noexcept {
+    MyVector(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  T* data() noexcept {
+    return data_;
+  }
+
+  const T* data() const noexcept {
+    return data_;
+  }
+
+  T& operator[](size_t index) noexcept {
+    return data_[index];
+  }
+
+  const T& operator[](size_t index) const noexcept {
+    return data_[index];
+  }
+
+  T& front() noexcept {
+    return data_[0];
+  }
+
+  const T& front() const noexcept {
+    return data_[0];
+  }
+
+  T& back() noexcept {
+    return data_[size_ - 1];
+  }
+
+  const T& back() const noexcept {
+    return data_[size_ - 1];
+  }
+
+  iterator begin() noexcept {
+    return data_;
+  }
+
+  const_iterator begin() const noexcept {
+    return data_;
+  }
+
+  iterator end() noexcept {
+    return data_ + size_;
+  }
+
+  const_iterator end() const noexcept {
+    return data_ + size_;
+  }
+
+  /**
+   * @brief Makes room for at least new_capacity elements without further growth.
+   */
+  void reserve(size_t new_capacity) {
+    if (new_capacity > capacity_) {
+      reallocate(new_capacity);
+    }
+  }
+
+  /**
+   * @brief Constructs an element at the end.
+   *
+   * The arguments may refer to elements of this vector.
+   *
+   * @param args Arguments forwarded to the constructor of T.
+   * @return A reference to the new element.
+   */
+  template<typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (size_ < capacity_) {
+      ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+    } else {
+      // Construct the element before growing, while arguments that refer into the buffer are valid.
+      Pending pending(std::forward<Args>(args)...);
+      reallocate(grown_capacity());
+      pending.move_to(data_ + size_);
+    }
+    return data_[size_++];
+  }
+
+  void push_back(const T& value) {
+    emplace_back(value);
+  }
+
+  void push_back(T&& value) {
+    emplace_back(std::move(value));
+  }
+
+  /**
+   * @brief Destroys the last element.
+   */
+  void pop_back() noexcept {
+    data_[--size_].~T();
+  }
+
+  /**
+   * @brief Constructs an element before pos, shifting the following elements back by one.
+   *
+   * The arguments may refer to elements of this vector.
+   *
+   * @param pos The position to insert at; end() appends.
+   * @param args Arguments forwarded to the constructor of T.
+   * @return An iterator to the new element.
+   */
+  template<typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    size_t index = static_cast<size_t>(pos - data_);
+    if (index == size_) {
+      emplace_back(std::forward<Args>(args)...);
+      return data_ + index;
+    }
+    if constexpr (MyIsTriviallyRelocatableV<T>) {
+      Pending pending(std::forward<Args>(args)...);
+      if (size_ == capacity_) {
+        reallocate(grown_capacity());
+      }
+      MyRelocate(data_ + index, size_ - index, data_ + index + 1);
+      pending.move_to(data_ + index);
+      ++size_;
+    } else {
+      T value(std::forward<Args>(args)...);
+      emplace_back(std::move(back()));
+      std::move_backward(data_ + index, data_ + size_ - 2, data_ + size_ - 1);
+      data_[index] = std::move(value);
+    }
+    return data_ + index;
+  }
+
+  iterator insert(const_iterator pos, const T& value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(const_iterator pos, T&& value) {
+    return emplace(pos, std::move(value));
+  }
+
+  /**
+   * @brief Destroys the element at pos and shifts the following elements forward by one.
+   *
+   * @return An iterator to the element that followed the erased one.
+   */
+  iterator erase(const_iterator pos) {
+    return erase(pos, pos + 1);
+  }
+
+  /**
+   * @brief Destroys the elements in [first, last) and shifts the following elements forward.
+   *
+   * @return An iterator to the element that followed the erased ones.
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    size_t index = static_cast<size_t>(first - data_);
+    size_t count = static_cast<size_t>(last - first);
+    if (count == 0) {
+      return data_ + index;
+    }
+    if constexpr (MyIsTriviallyRelocatableV<T>) {
+      std::destroy(data_ + index, data_ + index + count);
+      MyRelocate(data_ + index + count, size_ - index - count, data_ + index);
+    } else {
+      std::move(data_ + index + count, data_ + size_, data_ + index);
+      std::destroy(data_ + size_ - count, data_ + size_);
+    }
+    size_ -= count;
+    return data_ + index;
+  }
+
+  /**
+   * @brief Destroys all elements, keeping the buffer.
+   */
+  void clear() noexcept {
+    std::destroy(data_, data_ + size_);
+    size_ = 0;
+  }
+
+  /**
+   * @brief Exchanges the contents of two vectors.
+   */
+  void swap(MyVector& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+private:
+  static_assert(alignof(T) <= alignof(std::max_align_t), "MyVector does not support over-aligned types");
+
+  /**
+   * @brief An element constructed before the buffer is ready for it, in raw storage so that a
+   * trivially relocatable element can be moved into place with memcpy and never destroyed here.
+   */
+  class Pending {
+  public:
+    template<typename... Args>
+    explicit Pending(Args&&... args) {
+      ::new (static_cast<void*>(storage_)) T(std::forward<Args>(args)...);
+    }
+
+    Pending(const Pending&) = delete;
+    Pending& operator=(const Pending&) = delete;
+
+    ~Pending() {
+      if (!moved_) {
+        get()->~T();
+      }
+    }
+
+    void move_to(T* destination) {
+      if constexpr (MyIsTriviallyRelocatableV<T>) {
+        MyRelocate(get(), 1, destination);
+        moved_ = true;
+      } else {
+        ::new (static_cast<void*>(destination)) T(std::move(*get()));
+      }
+    }
+
+  private:
+    T* get() noexcept {
+      return std::launder(reinterpret_cast<T*>(storage_));
+    }
+
+    alignas(T) unsigned char storage_[sizeof(T)];
+    bool moved_ = false;
+  };
+
+  size_t grown_capacity() const {
+    return std::max<size_t>(capacity_ * 2, 4);
+  }
+
+  void reallocate(size_t new_capacity) {
+    if (new_capacity > SIZE_MAX / sizeof(T)) {
+      throw std::length_error("MyVector capacity overflow");
+    }
+    if constexpr (MyIsTriviallyRelocatableV<T>) {
+      void* data = std::realloc(static_cast<void*>(data_), new_capacity * sizeof(T));
+      if (data == nullptr) {
+        throw std::bad_alloc();
+      }
+      data_ = static_cast<T*>(data);
+    } else {
+      T* data = static_cast<T*>(std::malloc(new_capacity * sizeof(T)));
+      if (data == nullptr) {
+        throw std::bad_alloc();
+      }
+      size_t moved = 0;
+      try {
+        for (; moved < size_; ++moved) {
+          ::new (static_cast<void*>(data + moved)) T(std::move_if_noexcept(data_[moved]));
+        }
+      } catch (...) {
+        std::destroy(data, data + moved);
+        std::free(data);
+        throw;
+      }
+      std::destroy(data_, data_ + size_);
+      std::free(data_);
+      data_ = data;
+    }
+    capacity_ = new_capacity;
+  }
+
+  T* data_ = nullptr;    ///< The elements; allocated with std::malloc or std::realloc.
+  size_t size_ = 0;      ///< Number of constructed elements.
+  size_t capacity_ = 0;  ///< Number of elements the buffer can hold.
+};
+
+/**
+ * @brief Exchanges the contents of two vectors.
+ */
+template<typename T>
+void swap(MyVector<T>& lhs, MyVector<T>& rhs) noexcept {
+  lhs.swap(rhs);
+}
@@ -0,0 +1,19 @@
+#include <iostream>
+#include "my_string.h"
+#include "my_vector.h"
+
+int main() {
+  // MyString is trivially relocatable, so growing moves the strings with realloc.
+  MyVector<MyString> words;
+  for (const char* word : {"alpha", "bravo", "charlie", "delta", "echo"}) {
+    words.push_back(word);
+    std::cout << "size: " << words.size() << ", capacity: " << words.capacity() << std::endl;
+  }
+  std::cout << "--------------------------------" << std::endl;
+
+  words.insert(words.begin() + 1, "alpha-bis");
+  words.erase(words.begin() + 3);
+  for (const MyString& word : words) {
+    std::cout << word << std::endl;
+  }
+}
@@ -0,0 +1,3 @@
+#include "my_vector.h"
+
+// For template classes, all the implementation is in the header file.
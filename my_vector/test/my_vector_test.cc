@@ -0,0 +1,212 @@
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+#include "my_intrusive_ptr.h"
+#include "my_shared_ptr.h"
+#include "my_string.h"
+#include "my_unique_ptr.h"
+#include "my_vector.h"
+
+namespace {
+
+// Counts moves and destructions; opts in to relocation, so MyVector should do neither when it
+// merely shifts or regrows.
+struct Relocatable {
+  using is_trivially_relocatable = std::true_type;
+  static int moves;
+  static int destructions;
+  explicit Relocatable(int value) : value(value) {}
+  Relocatable(Relocatable&& other) noexcept : value(other.value) { ++moves; }
+  Relocatable& operator=(Relocatable&& other) noexcept {
+    value = other.value;
+    ++moves;
+    return *this;
+  }
+  ~Relocatable() { ++destructions; }
+  int value;
+};
+
+int Relocatable::moves = 0;
+int Relocatable::destructions = 0;
+
+// Points into itself, so it must be moved with its move constructor.
+class SelfReferential {
+ public:
+  explicit SelfReferential(int value) : value_(value), self_(&value_) {}
+  SelfReferential(const SelfReferential& other) : value_(other.value_), self_(&value_) {}
+  SelfReferential& operator=(const SelfReferential& other) {
+    value_ = other.value_;
+    return *this;
+  }
+  int value() const { return *self_; }
+  bool consistent() const { return self_ == &value_; }
+
+ private:
+  int value_;
+  int* self_;
+};
+
+struct Counted : MyRefCounted<Counted> {};
+
+// Counts live objects, and throws from the constructor once countdown reaches zero.
+struct Thrower {
+  static int live;
+  static int countdown;
+  Thrower() { Construct(); }
+  Thrower(const Thrower&) { Construct(); }
+  ~Thrower() { --live; }
+  static void Construct() {
+    if (countdown-- == 0) {
+      throw std::runtime_error("Thrower");
+    }
+    ++live;
+  }
+};
+
+int Thrower::live = 0;
+int Thrower::countdown = -1;
+
+}  // namespace
+
+TEST(MyVectorTest, Traits) {
+  static_assert(MyIsTriviallyRelocatableV<int>);
+  static_assert(MyIsTriviallyRelocatableV<MyUniquePtr<int>>);
+  static_assert(MyIsTriviallyRelocatableV<MyUniquePtr<int[]>>);
+  static_assert(MyIsTriviallyRelocatableV<MySharedPtr<int>>);
+  static_assert(MyIsTriviallyRelocatableV<MyWeakPtr<int>>);
+  static_assert(MyIsTriviallyRelocatableV<MyIntrusivePtr<Counted>>);
+  static_assert(MyIsTriviallyRelocatableV<MyString>);
+  static_assert(MyIsTriviallyRelocatableV<MyVector<MyString>>);
+  static_assert(!MyIsTriviallyRelocatableV<SelfReferential>);
+  static_assert(!MyIsTriviallyRelocatableV<std::string>);
+}
+
+TEST(MyVectorTest, PushBackAndIndex) {
+  MyVector<int> values;
+  EXPECT_TRUE(values.empty());
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(i);
+  }
+  EXPECT_EQ(values.size(), 100u);
+  EXPECT_GE(values.capacity(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+  EXPECT_EQ(values.front(), 0);
+  EXPECT_EQ(values.back(), 99);
+  values.pop_back();
+  EXPECT_EQ(values.back(), 98);
+}
+
+TEST(MyVectorTest, RelocatesWithoutMoving) {
+  Relocatable::moves = 0;
+  Relocatable::destructions = 0;
+  {
+    MyVector<Relocatable> values;
+    for (int i = 0; i < 100; ++i) {
+      values.emplace_back(i);
+    }
+    values.insert(values.begin(), Relocatable(-1));
+    values.erase(values.begin() + 10, values.begin() + 20);
+    EXPECT_EQ(values.size(), 91u);
+    EXPECT_EQ(values[0].value, -1);
+    EXPECT_EQ(values[10].value, 19);
+    // The temporary passed to insert() was moved from once; nothing else moved.
+    EXPECT_EQ(Relocatable::moves, 1);
+    // The erased elements and the temporary.
+    EXPECT_EQ(Relocatable::destructions, 11);
+  }
+  EXPECT_EQ(Relocatable::destructions, 102);
+}
+
+TEST(MyVectorTest, NonRelocatableElementsAreMoved) {
+  MyVector<SelfReferential> values;
+  for (int i = 0; i < 50; ++i) {
+    values.emplace_back(i);
+  }
+  values.insert(values.begin() + 5, SelfReferential(-5));
+  values.erase(values.begin());
+  EXPECT_EQ(values.size(), 50u);
+  EXPECT_EQ(values[4].value(), -5);
+  EXPECT_EQ(values[5].value(), 5);
+  for (const SelfReferential& value : values) {
+    EXPECT_TRUE(value.consistent());
+  }
+
+  MyVector<std::string> strings{"a", "b", "c"};
+  strings.insert(strings.begin() + 1, std::string(100, 'x'));
+  strings.erase(strings.begin());
+  EXPECT_EQ(strings[0], std::string(100, 'x'));
+  EXPECT_EQ(strings[2], "c");
+}
+
+TEST(MyVectorTest, OwningElements) {
+  MyVector<MyUniquePtr<int>> pointers;
+  for (int i = 0; i < 1000; ++i) {
+    pointers.push_back(MakeMyUnique<int>(i));
+  }
+  pointers.erase(pointers.begin(), pointers.begin() + 500);
+  EXPECT_EQ(*pointers.front(), 500);
+
+  MyVector<MyString> strings;
+  for (int i = 0; i < 1000; ++i) {
+    strings.push_back(MyString(std::to_string(i).c_str()));
+  }
+  strings.insert(strings.begin(), MyString("first"));
+  EXPECT_STREQ(strings[0].c_str(), "first");
+  EXPECT_STREQ(strings[1000].c_str(), "999");
+
+  MySharedPtr<int> shared = MakeMyShared<int>(7);
+  {
+    MyVector<MySharedPtr<int>> copies(3);
+    for (int i = 0; i < 100; ++i) {
+      copies.push_back(shared);
+    }
+    EXPECT_EQ(shared.use_count(), 101u);
+  }
+  EXPECT_EQ(shared.use_count(), 1u);
+}
+
+TEST(MyVectorTest, ArgumentsMayReferToElements) {
+  MyVector<MyString> strings{"zero"};
+  for (int i = 0; i < 10; ++i) {
+    strings.push_back(strings[0]);
+    strings.insert(strings.begin(), strings.back());
+  }
+  for (const MyString& string : strings) {
+    EXPECT_STREQ(string.c_str(), "zero");
+  }
+}
+
+TEST(MyVectorTest, CopyAndMove) {
+  MyVector<MyString> original{"a", "b"};
+  MyVector<MyString> copy(original);
+  EXPECT_STREQ(copy[1].c_str(), "b");
+  MyVector<MyString> moved(std::move(original));
+  EXPECT_TRUE(original.empty());
+  EXPECT_STREQ(moved[0].c_str(), "a");
+  original = moved;
+  EXPECT_EQ(original.size(), 2u);
+  copy = std::move(moved);
+  EXPECT_EQ(copy.size(), 2u);
+}
+
+TEST(MyVectorTest, ThrowingConstructorsLeakNothing) {
+  Thrower::countdown = 2;
+  EXPECT_THROW(MyVector<Thrower> v(5), std::runtime_error);
+  EXPECT_EQ(Thrower::live, 0);
+
+  Thrower::countdown = -1;
+  Thrower element;
+  // The first three copies fill the initializer list; the sixth is the vector's third.
+  Thrower::countdown = 5;
+  EXPECT_THROW((MyVector<Thrower>{element, element, element}), std::runtime_error);
+  EXPECT_EQ(Thrower::live, 1);
+
+  Thrower::countdown = -1;
+  MyVector<Thrower> original(3);
+  Thrower::countdown = 2;
+  EXPECT_THROW(MyVector<Thrower> copy(original), std::runtime_error);
+  EXPECT_EQ(Thrower::live, 4);
+  Thrower::countdown = -1;
+}